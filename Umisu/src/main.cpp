@@ -1,28 +1,69 @@
 #include "York/Graphics/Vulkan/debug.hpp"
 #include <York/Graphics/Vulkan/instance.hpp>
-#include <York/Platform/Wayland/layer.hpp>
+#include <York/Platform/Wayland/wayland.hpp>
 #include <York/Core/logger.hpp>
+#include <York/Core/profiler.hpp>
+#include <algorithm>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 using namespace york;
 
 static vulkan::UserDebugCallback DebugCallback = [](std::string_view severity, std::string_view type, std::string_view msg) {
-  YORK_VULKAN_LOG_CRITICAL("DebugMessenger [{} & {}]: {}", severity, type, msg);
+  YK_VULKAN_LOG_CRITICAL("DebugMessenger [{} & {}]: {}", severity, type, msg);
 };
 
-int main() {
-  york::Logger::init();
+// Creates a layer on every output that has none yet, at startup and when outputs are plugged in
+// Outputs whose layer could not be created are logged once and skipped afterwards
+static Result<> AddOutputLayers(std::vector<std::unique_ptr<Window<Wayland>>> &windows, std::vector<uint32_t> &failedOutputs) {
+  auto outputs = Window<Wayland>::EnumerateOutputs();
+  if (!outputs)
+    return YK_RESULT_FAILURE(outputs.error());
+
+  for (const auto &output : *outputs) {
+    const bool covered = std::ranges::any_of(windows, [&](const auto &window) { return window->GetCreateInfo().Output == output.ID; });
+    if (covered || std::ranges::contains(failedOutputs, output.ID))
+      continue;
+
+    auto result = Window<Wayland>::Create({
+        .Title = "Main Window",
+        .Width = 800,
+        .Height = 800,
+        .IsLayer = true,
+        .Output = output.ID,
+    });
 
-  std::unique_ptr<Layer<Wayland>> window;
-  {
-    auto result = Layer<Wayland>::Create("Main Window", 800, 800);
     if (!result) {
-      YORK_RUNTIME_LOG_CRITICAL(result.error().message);
-      return -1;
+      YK_RUNTIME_LOG_ERROR("Layer on {} failed: {}", output.Name, result.error().message);
+      failedOutputs.push_back(output.ID);
+      continue;
     }
-    result->swap(window);
+    YK_RUNTIME_LOG_INFO("Layer on {} ({}x{} @ {} mHz)", output.Name, output.Width, output.Height, output.RefreshMilliHz);
+    windows.emplace_back(std::move(*result));
+  }
+
+  return YK_RESULT_SUCCESS({});
+}
+
+int main() {
+  york::Logger::init();
+  york::Profiler::SetEnabled(true);
+
+  // One layer per output, each paced by the frame callbacks of its own output
+  // Render extents stay at the logical size until a device feeds GPU timings to a ResolutionScaler
+  // Without any output yet the loop waits for one to be plugged in
+  std::vector<std::unique_ptr<Window<Wayland>>> windows;
+  std::vector<uint32_t> failedOutputs;
+  if (auto result = AddOutputLayers(windows, failedOutputs); !result) {
+    YK_RUNTIME_LOG_CRITICAL(result.error().message);
+    return -1;
+  }
+  if (windows.empty() && !failedOutputs.empty()) {
+    YK_RUNTIME_LOG_CRITICAL("No layer could be created on any output");
+    return -1;
   }
+
   std::shared_ptr<vulkan::Instance> instance;
   {
     auto result = vulkan::Instance::Create<Wayland>({
@@ -33,7 +74,7 @@ int main() {
     });
 
     if (!result) {
-      YORK_RUNTIME_LOG_CRITICAL(result.error().message);
+      YK_RUNTIME_LOG_CRITICAL(result.error().message);
       return -1;
     }
     result->swap(instance);
@@ -47,19 +88,33 @@ int main() {
     });
 
     if (!result) {
-      YORK_RUNTIME_LOG_CRITICAL(result.error().message);
+      YK_RUNTIME_LOG_CRITICAL(result.error().message);
       return -1;
     }
   }
 
   auto d = instance->EnumeratePhysicalDevices();
 
+  // Layers come and go with their outputs, the loop only ends with the connection to the compositor
   while (true) {
-    if (auto status = window->Frame(); !status.has_value()) {
-      YORK_ENGINE_LOG_CRITICAL(status.error());
+    YK_PROFILE_FRAME_BEGIN();
+    // Simulation ticks once per loop, every output that is ready presents the same state
+    bool anyReady = false;
+    for (auto &window : windows) {
+      if (window->ShouldRender()) {
+        window->Present();
+        anyReady = true;
+      }
+    }
+
+    // The compositor is gone (or killed the connection), no layer will ever be shown again
+    if (auto result = Window<Wayland>::DispatchEvents(anyReady ? 0 : 250); !result) {
+      YK_RUNTIME_LOG_CRITICAL(result.error().message);
       return -1;
     }
+    std::erase_if(windows, [](const auto &window) { return window->IsClosed(); });
+    if (auto result = AddOutputLayers(windows, failedOutputs); !result)
+      YK_RUNTIME_LOG_ERROR(result.error().message);
+    YK_PROFILE_FRAME_END();
   }
-
-  return 0;
 }
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "bench.hpp"
+#include "York/Core/error.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <map>
+#include <memory>
+#include <string_view>
+
+namespace york::bench {
+
+// =====================
+// Statistics
+// =====================
+Percentiles ComputePercentiles(std::vector<double> &samples) {
+  if (samples.empty())
+    return {};
+
+  std::sort(samples.begin(), samples.end());
+  auto rank = [&](double p) {
+    auto index = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+    return samples[std::clamp<size_t>(index, 1, samples.size()) - 1];
+  };
+
+  return {.P50 = rank(0.50), .P95 = rank(0.95), .P99 = rank(0.99)};
+}
+
+// =====================
+// JSON Output
+// =====================
+static std::string ToJSON(const Percentiles &p) {
+  return std::format(R"({{"p50": {:.4f}, "p95": {:.4f}, "p99": {:.4f}}})", p.P50, p.P95, p.P99);
+}
+
+std::string ToJSON(const std::vector<Report> &reports) {
+  std::string json = "{\n  \"reports\": [";
+  for (size_t i(0); i < reports.size(); ++i) {
+    const auto &r = reports[i];
+    json += i == 0 ? "\n" : ",\n";
+    json += "    {\n";
+    json += std::format("      \"scene\": \"{}\",\n", r.Scene);
+    json += std::format("      \"mode\": \"{}\",\n", r.Mode);
+    json += std::format("      \"device\": \"{}\",\n", r.Device);
+    json += std::format("      \"frames\": {},\n", r.Frames);
+    json += std::format("      \"startup_ms\": {:.4f},\n", r.StartupMs);
+    json += std::format("      \"cpu_ms\": {},\n", ToJSON(r.CPUMs));
+    json += std::format("      \"allocations_per_frame\": {:.4f}\n", r.AllocationsPerFrame);
+    json += "    }";
+  }
+  json += "\n  ]\n}\n";
+  return json;
+}
+
+// =====================
+// JSON Input
+// =====================
+// Just enough JSON to read back files written by ToJSON
+struct JSONValue {
+  std::string String;
+  double Number = 0.0;
+  std::map<std::string, JSONValue> Object;
+  std::vector<JSONValue> Array;
+
+  const JSONValue *Find(const std::string &key) const {
+    auto it = Object.find(key);
+    return it == Object.end() ? nullptr : &it->second;
+  }
+};
+
+class JSONParser {
+public:
+  explicit JSONParser(std::string_view text) : m_Text(text) {}
+
+  Result<JSONValue> Parse() {
+    JSONValue value;
+    if (!ParseValue(value))
+      return YK_RESULT_FAILURE(Error::Create(std::format("Invalid JSON near offset {}", m_Pos)));
+    return value;
+  }
+
+private:
+  void SkipSpaces() {
+    while (m_Pos < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Pos])))
+      m_Pos++;
+  }
+
+  bool Consume(char c) {
+    SkipSpaces();
+    if (m_Pos >= m_Text.size() || m_Text[m_Pos] != c)
+      return false;
+    m_Pos++;
+    return true;
+  }
+
+  bool ParseString(std::string &out) {
+    if (!Consume('"'))
+      return false;
+    while (m_Pos < m_Text.size() && m_Text[m_Pos] != '"') {
+      if (m_Text[m_Pos] == '\\' && m_Pos + 1 < m_Text.size())
+        m_Pos++;
+      out += m_Text[m_Pos++];
+    }
+    return Consume('"');
+  }
+
+  bool ParseValue(JSONValue &value) {
+    SkipSpaces();
+    if (m_Pos >= m_Text.size())
+      return false;
+
+    const char c = m_Text[m_Pos];
+    if (c == '"')
+      return ParseString(value.String);
+
+    if (c == '{') {
+      m_Pos++;
+      if (Consume('}'))
+        return true;
+      do {
+        std::string key;
+        if (!ParseString(key) || !Consume(':') || !ParseValue(value.Object[key]))
+          return false;
+      } while (Consume(','));
+      return Consume('}');
+    }
+
+    if (c == '[') {
+      m_Pos++;
+      if (Consume(']'))
+        return true;
+      do {
+        if (!ParseValue(value.Array.emplace_back()))
+          return false;
+      } while (Consume(','));
+      return Consume(']');
+    }
+
+    const char *begin = m_Text.data() + m_Pos;
+    char *end = nullptr;
+    value.Number = std::strtod(begin, &end);
+    if (end == begin)
+      return false;
+    m_Pos += static_cast<size_t>(end - begin);
+    return true;
+  }
+
+private:
+  std::string_view m_Text;
+  size_t m_Pos = 0;
+};
+
+static Percentiles ReadPercentiles(const JSONValue *value) {
+  if (!value)
+    return {};
+
+  auto number = [&](const char *key) { auto *v = value->Find(key); return v ? v->Number : 0.0; };
+  return {.P50 = number("p50"), .P95 = number("p95"), .P99 = number("p99")};
+}
+
+Result<std::vector<Report>> ParseJSON(const std::string &json) {
+  auto root = JSONParser(json).Parse();
+  if (!root)
+    return YK_RESULT_FAILURE(root.error());
+
+  const JSONValue *reports = root->Find("reports");
+  if (!reports)
+    return YK_RESULT_FAILURE(Error::Create("Baseline has no \"reports\" array"));
+
+  std::vector<Report> result;
+  for (const auto &entry : reports->Array) {
+    auto string = [&](const char *key) { auto *v = entry.Find(key); return v ? v->String : std::string(); };
+    auto number = [&](const char *key) { auto *v = entry.Find(key); return v ? v->Number : 0.0; };
+
+    result.push_back({
+        .Scene = string("scene"),
+        .Mode = string("mode"),
+        .Device = string("device"),
+        .Frames = static_cast<uint32_t>(number("frames")),
+        .StartupMs = number("startup_ms"),
+        .CPUMs = ReadPercentiles(entry.Find("cpu_ms")),
+        .AllocationsPerFrame = number("allocations_per_frame"),
+    });
+  }
+
+  return result;
+}
+
+// =====================
+// Baseline Comparison
+// =====================
+std::vector<Regression> Compare(const Report &baseline, const Report &current, double thresholdPercent) {
+  std::vector<Regression> regressions;
+  const double factor = 1.0 + thresholdPercent / 100.0;
+
+  auto check = [&](const char *metric, double base, double now) {
+    // Metrics missing from the baseline are not compared
+    if (base <= 0.0)
+      return;
+    if (now > base * factor)
+      regressions.push_back({.Metric = metric, .Baseline = base, .Current = now});
+  };
+
+  check("startup_ms", baseline.StartupMs, current.StartupMs);
+  check("cpu_ms.p50", baseline.CPUMs.P50, current.CPUMs.P50);
+  check("cpu_ms.p95", baseline.CPUMs.P95, current.CPUMs.P95);
+  check("cpu_ms.p99", baseline.CPUMs.P99, current.CPUMs.P99);
+
+  // Allocation counts are exact, any growth beyond the threshold is reported even from zero
+  if (current.AllocationsPerFrame > baseline.AllocationsPerFrame * factor && current.AllocationsPerFrame - baseline.AllocationsPerFrame >= 1.0)
+    regressions.push_back({.Metric = "allocations_per_frame", .Baseline = baseline.AllocationsPerFrame, .Current = current.AllocationsPerFrame});
+
+  return regressions;
+}
+
+} // namespace york::bench
@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+ * York Frame-Time Benchmark Helpers
+ */
+
+#include "York/Core/result.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace york::bench {
+
+// Scenes are driven only by the frame time, never the wall clock, so runs are reproducible
+// Update receives the animation time of the frame: frameIndex * FIXED_TIMESTEP
+static constexpr double FIXED_TIMESTEP = 1.0 / 60.0;
+
+struct Scene {
+  std::string Name;
+  std::function<Result<>()> Load;
+  std::function<void(double time)> Update;
+};
+
+struct Percentiles {
+  double P50 = 0.0;
+  double P95 = 0.0;
+  double P99 = 0.0;
+};
+
+struct Report {
+  std::string Scene;
+  std::string Mode;
+  std::string Device;
+  uint32_t Frames = 0;
+  double StartupMs = 0.0;
+  Percentiles CPUMs;
+  double AllocationsPerFrame = 0.0;
+};
+
+struct Regression {
+  std::string Metric;
+  double Baseline = 0.0;
+  double Current = 0.0;
+};
+
+// Fixed scene set (scenes.cpp), every scene must be deterministic for a given frame index
+std::vector<Scene> GetScenes();
+
+// Nearest-rank percentiles, samples are sorted in place
+Percentiles ComputePercentiles(std::vector<double> &samples);
+
+std::string ToJSON(const std::vector<Report> &reports);
+Result<std::vector<Report>> ParseJSON(const std::string &json);
+
+// A metric regresses when it grows by more than thresholdPercent over the baseline of the same scene
+std::vector<Regression> Compare(const Report &baseline, const Report &current, double thresholdPercent);
+
+} // namespace york::bench
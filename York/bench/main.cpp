@@ -0,0 +1,256 @@
+#include "bench.hpp"
+#include <York/Core/logger.hpp>
+#include <York/Core/profiler.hpp>
+#include <York/Graphics/Vulkan/instance.hpp>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string_view>
+
+using namespace york;
+
+// =====================
+// Allocation Counting
+// =====================
+static std::atomic<uint64_t> g_Allocations = 0;
+
+void *operator new(std::size_t size) {
+  g_Allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+// =====================
+// Options
+// =====================
+struct Options {
+  std::string Scene = "all";
+  uint32_t Frames = 1000;
+  uint32_t Warmup = 60;
+  uint32_t Width = 800;
+  uint32_t Height = 800;
+  std::string Device;
+  std::string Output;
+  std::string Baseline;
+  double Threshold = 5.0;
+};
+
+static constexpr std::string_view USAGE = R"(Usage: york_bench [options]
+  --scene <name|all>     Scene to run (default: all)
+  --frames <n>           Measured frames per scene (default: 1000)
+  --warmup <n>           Unmeasured frames before measuring (default: 60)
+  --size <w>x<h>         Window extent (default: 800x800)
+  --device <substring>   Pick the first physical device whose name contains it
+  --out <file>           Write the JSON report to a file instead of stdout
+  --baseline <file>      Compare against a previous report, exit code 2 on regressions
+  --threshold <percent>  Allowed growth over the baseline (default: 5)
+)";
+
+template <typename T>
+static bool ParseNumber(std::string_view str, T &out) {
+  auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), out);
+  return ec == std::errc() && ptr == str.data() + str.size();
+}
+
+static Result<Options> ParseOptions(int argc, char **argv) {
+  Options options;
+  for (int i(1); i < argc; ++i) {
+    std::string_view arg = argv[i];
+    auto next = [&]() -> std::string_view { return i + 1 < argc ? argv[++i] : std::string_view(); };
+
+    bool valid = true;
+    if (arg == "--scene")
+      options.Scene = next();
+    else if (arg == "--frames")
+      valid = ParseNumber(next(), options.Frames);
+    else if (arg == "--warmup")
+      valid = ParseNumber(next(), options.Warmup);
+    else if (arg == "--size") {
+      auto size = next();
+      auto x = size.find('x');
+      valid = x != std::string_view::npos && ParseNumber(size.substr(0, x), options.Width) && ParseNumber(size.substr(x + 1), options.Height);
+    } else if (arg == "--device")
+      options.Device = next();
+    else if (arg == "--out")
+      options.Output = next();
+    else if (arg == "--baseline")
+      options.Baseline = next();
+    else if (arg == "--threshold")
+      valid = ParseNumber(next(), options.Threshold);
+    else
+      valid = false;
+
+    if (!valid)
+      return YK_RESULT_FAILURE(Error::Create(std::format("Invalid argument: {}\n{}", arg, USAGE)));
+  }
+
+  if (options.Frames == 0)
+    return YK_RESULT_FAILURE(Error::Create("--frames must be greater than 0"));
+
+  return options;
+}
+
+// =====================
+// Benchmark Run
+// =====================
+// Reports CPU frame time (scene update and window frame, minus present wait) and allocations
+// No device renders yet, GPU timings and memory join the report once scenes draw through a GPUProfiler
+// Runs are headless only: nothing presents into a layer surface yet, so it is never mapped and every windowed
+// frame would sleep the idle tick waiting on a frame callback that never comes
+template <typename Platform>
+static Result<bench::Report> Run(const Options &options, const bench::Scene &scene) {
+  const uint64_t startupBegin = Profiler::Now();
+
+  std::shared_ptr<vulkan::Instance> instance;
+  {
+    auto result = vulkan::Instance::Create<Platform>({.AppName = "york_bench", .EngineName = "York"});
+    if (!result)
+      return YK_RESULT_FAILURE(result.error());
+    result->swap(instance);
+  }
+
+  std::unique_ptr<Window<Platform>> window;
+  {
+    auto result = Window<Platform>::Create({.Title = "york_bench", .Width = options.Width, .Height = options.Height, .IsLayer = true});
+    if (!result)
+      return YK_RESULT_FAILURE(result.error());
+    result->swap(window);
+  }
+
+  auto devices = instance->EnumeratePhysicalDevices();
+  auto device = std::find_if(devices.begin(), devices.end(), [&](const vulkan::PhysicalDevice &d) { return d.Name.contains(options.Device); });
+  if (device == devices.end())
+    return YK_RESULT_FAILURE(Error::Create(std::format("No physical device matching \"{}\"", options.Device)));
+
+  if (auto result = scene.Load(); !result)
+    return YK_RESULT_FAILURE(result.error());
+
+  bench::Report report{
+      .Scene = scene.Name,
+      .Mode = "headless",
+      .Device = device->Name,
+      .Frames = options.Frames,
+      .StartupMs = static_cast<double>(Profiler::Now() - startupBegin) / 1e6,
+  };
+
+  std::vector<double> cpu;
+  cpu.reserve(options.Frames);
+  uint64_t allocations = 0;
+
+  Profiler::SetEnabled(true);
+  for (uint32_t frame(0); frame < options.Warmup + options.Frames; ++frame) {
+    const bool measured = frame >= options.Warmup;
+    const uint64_t allocationsBegin = g_Allocations.load(std::memory_order_relaxed);
+
+    Profiler::BeginFrame();
+    scene.Update(static_cast<double>(frame) * bench::FIXED_TIMESTEP);
+    // Benchmarks measure full redraws, idle skipping would hide the cost being measured
+    window->AddFullDamage();
+    auto result = window->Frame();
+    Profiler::EndFrame();
+    if (!result) {
+      Profiler::SetEnabled(false);
+      return YK_RESULT_FAILURE(result.error());
+    }
+
+    if (!measured)
+      continue;
+
+    allocations += g_Allocations.load(std::memory_order_relaxed) - allocationsBegin;
+    // Blocking on the compositor is not CPU work
+    const FrameSummary summary = Profiler::GetLatestSummary();
+    cpu.push_back(summary.CPUMs - summary.PresentWaitMs);
+  }
+  Profiler::SetEnabled(false);
+
+  report.CPUMs = bench::ComputePercentiles(cpu);
+  report.AllocationsPerFrame = static_cast<double>(allocations) / options.Frames;
+  return report;
+}
+
+static Result<std::string> ReadFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Failed to open {}", path)));
+
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+int main(int argc, char **argv) {
+  york::Logger::init();
+
+  auto options = ParseOptions(argc, argv);
+  if (!options) {
+    YK_RUNTIME_LOG_CRITICAL(options.error().message);
+    return 1;
+  }
+
+  std::vector<bench::Report> reports;
+  for (const auto &scene : bench::GetScenes()) {
+    if (options->Scene != "all" && options->Scene != scene.Name)
+      continue;
+
+    auto report = Run<Headless>(*options, scene);
+    if (!report) {
+      YK_RUNTIME_LOG_CRITICAL("Scene {} failed: {}", scene.Name, report.error().message);
+      return 1;
+    }
+    reports.emplace_back(*report);
+  }
+
+  if (reports.empty()) {
+    YK_RUNTIME_LOG_CRITICAL("Unknown scene: {}", options->Scene);
+    return 1;
+  }
+
+  const std::string json = bench::ToJSON(reports);
+  if (options->Output.empty()) {
+    std::fwrite(json.data(), 1, json.size(), stdout);
+  } else if (std::ofstream out(options->Output); !(out << json)) {
+    YK_RUNTIME_LOG_CRITICAL("Failed to write {}", options->Output);
+    return 1;
+  }
+
+  if (options->Baseline.empty())
+    return 0;
+
+  auto baselineText = ReadFile(options->Baseline);
+  if (!baselineText) {
+    YK_RUNTIME_LOG_CRITICAL(baselineText.error().message);
+    return 1;
+  }
+
+  auto baseline = bench::ParseJSON(*baselineText);
+  if (!baseline) {
+    YK_RUNTIME_LOG_CRITICAL(baseline.error().message);
+    return 1;
+  }
+
+  bool regressed = false;
+  for (const auto &current : reports) {
+    auto base = std::find_if(baseline->begin(), baseline->end(), [&](const bench::Report &r) { return r.Scene == current.Scene && r.Mode == current.Mode; });
+    if (base == baseline->end()) {
+      YK_RUNTIME_LOG_WARN("Scene {} ({}) has no baseline", current.Scene, current.Mode);
+      continue;
+    }
+
+    for (const auto &regression : bench::Compare(*base, current, options->Threshold)) {
+      regressed = true;
+      YK_RUNTIME_LOG_ERROR("REGRESSION {} [{}]: {} {:.4f} -> {:.4f}", current.Scene, current.Mode, regression.Metric,
+                           regression.Baseline, regression.Current);
+    }
+  }
+
+  return regressed ? 2 : 0;
+}
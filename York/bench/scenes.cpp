@@ -0,0 +1,254 @@
+#include "bench.hpp"
+#include "York/Physics/spring_bones.hpp"
+#include "York/Scene/draw_list.hpp"
+#include "York/Scene/transform_hierarchy.hpp"
+#include <cmath>
+#include <memory>
+
+namespace york::bench {
+
+// =====================
+// Camera
+// =====================
+// Right-handed view looking at target, Vulkan clip space (y down, depth 0..1)
+static Mat4 MakeViewProjection(const Vec3 &eye, const Vec3 &target, float tanHalfFovY, float aspect, float near, float far) {
+  const Vec3 f = Normalize(target - eye);
+  const Vec3 s = Normalize(Cross(f, {0.0f, 1.0f, 0.0f}));
+  const Vec3 u = Cross(s, f);
+
+  Mat4 view;
+  view(0, 0) = s.X, view(0, 1) = s.Y, view(0, 2) = s.Z, view(0, 3) = -Dot(s, eye);
+  view(1, 0) = u.X, view(1, 1) = u.Y, view(1, 2) = u.Z, view(1, 3) = -Dot(u, eye);
+  view(2, 0) = -f.X, view(2, 1) = -f.Y, view(2, 2) = -f.Z, view(2, 3) = Dot(f, eye);
+
+  Mat4 projection;
+  projection(0, 0) = 1.0f / (aspect * tanHalfFovY);
+  projection(1, 1) = -1.0f / tanHalfFovY;
+  projection(2, 2) = far / (near - far);
+  projection(2, 3) = near * far / (near - far);
+  projection(3, 2) = -1.0f;
+  projection(3, 3) = 0.0f;
+
+  return projection * view;
+}
+
+// =====================
+// Transforms
+// =====================
+// 64 skeletons of 64 joints (binary trees), every joint animated each frame, skinning matrices written out
+static Scene MakeTransformsScene() {
+  struct State {
+    std::unique_ptr<TransformHierarchy> Hierarchy;
+    std::vector<Mat4> Joints;
+  };
+  auto state = std::make_shared<State>();
+
+  static constexpr uint32_t SKELETONS = 64;
+  static constexpr uint32_t JOINTS = 64;
+
+  return {
+      .Name = "transforms",
+      .Load = [state]() -> Result<> {
+        TransformHierarchyCreateInfo createInfo;
+        for (uint32_t s(0); s < SKELETONS; ++s) {
+          const uint32_t first = s * JOINTS;
+          SkinCreateInfo skin;
+          for (uint32_t j(0); j < JOINTS; ++j) {
+            createInfo.Nodes.push_back({
+                .Parent = j == 0 ? -1 : static_cast<int32_t>(first + (j - 1) / 2),
+                .Translation = j == 0 ? Vec3{static_cast<float>(s % 8) * 2.0f, 0.0f, static_cast<float>(s / 8) * 2.0f} : Vec3{0.0f, 0.1f, 0.0f},
+            });
+            skin.Joints.push_back(first + j);
+            skin.InverseBindMatrices.emplace_back();
+          }
+          createInfo.Skins.emplace_back(std::move(skin));
+        }
+
+        auto hierarchy = TransformHierarchy::Create(createInfo);
+        if (!hierarchy)
+          return YK_RESULT_FAILURE(hierarchy.error());
+        state->Hierarchy = std::move(*hierarchy);
+        state->Joints.resize(state->Hierarchy->GetTotalJointCount());
+        return YK_RESULT_SUCCESS({});
+      },
+      .Update = [state](double time) {
+        auto &hierarchy = *state->Hierarchy;
+        for (uint32_t i(0); i < SKELETONS * JOINTS; ++i) {
+          if (i % JOINTS == 0)
+            continue;
+          const float angle = 0.3f * static_cast<float>(std::sin(time * 2.0 + i * 0.1));
+          hierarchy.SetRotation(hierarchy.GetNodeIndex(i), {0.0f, 0.0f, std::sin(angle * 0.5f), std::cos(angle * 0.5f)});
+        }
+        hierarchy.Update();
+        hierarchy.WriteJointMatrices(state->Joints.data());
+      },
+  };
+}
+
+// =====================
+// Culling
+// =====================
+// 128x128 grid of objects with 3 LODs under an orbiting camera, a quarter of them moving every frame
+static Scene MakeCullingScene() {
+  struct State {
+    std::unique_ptr<DrawList> List;
+    std::vector<AABB> Bounds;
+  };
+  auto state = std::make_shared<State>();
+
+  static constexpr uint32_t GRID = 128;
+  static constexpr float SPACING = 4.0f;
+  static constexpr float TAN_HALF_FOV_Y = 0.57735f; // 60 degrees
+
+  return {
+      .Name = "culling",
+      .Load = [state]() -> Result<> {
+        DrawListCreateInfo createInfo;
+        for (uint32_t i(0); i < GRID * GRID; ++i) {
+          const Vec3 center{(static_cast<float>(i % GRID) - GRID / 2) * SPACING, 0.5f, (static_cast<float>(i / GRID) - GRID / 2) * SPACING};
+          const AABB bounds{center - Vec3{0.5f, 0.5f, 0.5f}, center + Vec3{0.5f, 0.5f, 0.5f}};
+          createInfo.Objects.push_back({
+              .Bounds = bounds,
+              .SortKey = i % 16,
+              .LODCount = 3,
+              .LODScreenSizes = {0.1f, 0.02f},
+          });
+          state->Bounds.push_back(bounds);
+        }
+
+        auto list = DrawList::Create(createInfo);
+        if (!list)
+          return YK_RESULT_FAILURE(list.error());
+        state->List = std::move(*list);
+        return YK_RESULT_SUCCESS({});
+      },
+      .Update = [state](double time) {
+        auto &list = *state->List;
+        const float bob = static_cast<float>(std::sin(time * 3.0));
+        for (uint32_t i(0); i < state->Bounds.size(); i += 4) {
+          const Vec3 offset{0.0f, bob, 0.0f};
+          list.SetBounds(i, {state->Bounds[i].Min + offset, state->Bounds[i].Max + offset});
+        }
+
+        const float angle = static_cast<float>(time * 0.5);
+        const Vec3 eye{std::cos(angle) * 60.0f, 20.0f, std::sin(angle) * 60.0f};
+        list.Build({
+            .ViewProjection = MakeViewProjection(eye, {}, TAN_HALF_FOV_Y, 1.0f, 0.1f, 1000.0f),
+            .Eye = eye,
+            .TanHalfFovY = TAN_HALF_FOV_Y,
+            .MinScreenSize = 0.002f,
+        });
+      },
+  };
+}
+
+// =====================
+// Spring Bones
+// =====================
+// 500 hair chains of 8 joints around a head under 16 body colliders (head, neck, torso and arms)
+// The character turns and sways, one fixed substep per frame on the calling thread
+static Scene MakeSpringBonesScene() {
+  struct State {
+    std::unique_ptr<TransformHierarchy> Hierarchy;
+    std::unique_ptr<SpringBoneSolver> Solver;
+    uint32_t Root = 0;
+  };
+  auto state = std::make_shared<State>();
+
+  static constexpr uint32_t CHAINS = 500;
+  static constexpr uint32_t JOINTS = 8;
+  static constexpr float HEAD_Y = 1.6f;
+
+  return {
+      .Name = "spring_bones",
+      .Load = [state]() -> Result<> {
+        // Source node 0 is the animated root, chain joints follow chain by chain
+        TransformHierarchyCreateInfo hierarchyCI;
+        hierarchyCI.Nodes.push_back({});
+        for (uint32_t c(0); c < CHAINS; ++c) {
+          // Roots spread over the upper half of the head, golden angle spiral
+          const float height = 0.02f + 0.08f * static_cast<float>(c) / CHAINS;
+          const float ring = std::sqrt(std::max(0.1f * 0.1f - (height - 0.02f) * (height - 0.02f), 0.0f)) + 0.02f;
+          const float angle = static_cast<float>(c) * 2.39996f;
+          for (uint32_t j(0); j < JOINTS; ++j) {
+            hierarchyCI.Nodes.push_back({
+                .Parent = j == 0 ? 0 : static_cast<int32_t>(hierarchyCI.Nodes.size() - 1),
+                .Translation = j == 0 ? Vec3{std::cos(angle) * ring, HEAD_Y + height, std::sin(angle) * ring} : Vec3{0.0f, -0.05f, 0.0f},
+            });
+          }
+        }
+
+        auto hierarchy = TransformHierarchy::Create(hierarchyCI);
+        if (!hierarchy)
+          return YK_RESULT_FAILURE(hierarchy.error());
+        state->Hierarchy = std::move(*hierarchy);
+        state->Root = state->Hierarchy->GetNodeIndex(0);
+        state->Hierarchy->Update();
+
+        SpringBoneSolverCreateInfo solverCI{.Hierarchy = state->Hierarchy.get()};
+        for (uint32_t c(0); c < CHAINS; ++c) {
+          SpringChainCreateInfo chain{.Stiffness = 0.8f, .GravityPower = 0.5f};
+          for (uint32_t j(0); j < JOINTS; ++j)
+            chain.Joints.push_back(state->Hierarchy->GetNodeIndex(1 + c * JOINTS + j));
+          solverCI.Chains.emplace_back(std::move(chain));
+        }
+
+        // Sphere when Offset equals Tail
+        const SpringColliderCreateInfo colliders[] = {
+            {.Offset = {0.0f, HEAD_Y, 0.0f}, .Tail = {0.0f, HEAD_Y, 0.0f}, .Radius = 0.1f},
+            {.Offset = {0.0f, 1.42f, 0.0f}, .Tail = {0.0f, 1.52f, 0.0f}, .Radius = 0.05f},
+            {.Offset = {-0.08f, 1.38f, 0.0f}, .Tail = {-0.18f, 1.38f, 0.0f}, .Radius = 0.05f},
+            {.Offset = {0.08f, 1.38f, 0.0f}, .Tail = {0.18f, 1.38f, 0.0f}, .Radius = 0.05f},
+            {.Offset = {-0.2f, 1.36f, 0.0f}, .Tail = {-0.22f, 1.1f, 0.0f}, .Radius = 0.045f},
+            {.Offset = {0.2f, 1.36f, 0.0f}, .Tail = {0.22f, 1.1f, 0.0f}, .Radius = 0.045f},
+            {.Offset = {-0.22f, 1.1f, 0.0f}, .Tail = {-0.24f, 0.86f, 0.05f}, .Radius = 0.04f},
+            {.Offset = {0.22f, 1.1f, 0.0f}, .Tail = {0.24f, 0.86f, 0.05f}, .Radius = 0.04f},
+            {.Offset = {-0.24f, 0.86f, 0.05f}, .Tail = {-0.24f, 0.86f, 0.05f}, .Radius = 0.05f},
+            {.Offset = {0.24f, 0.86f, 0.05f}, .Tail = {0.24f, 0.86f, 0.05f}, .Radius = 0.05f},
+            {.Offset = {-0.06f, 1.3f, 0.03f}, .Tail = {0.06f, 1.3f, 0.03f}, .Radius = 0.1f},
+            {.Offset = {-0.06f, 1.3f, -0.03f}, .Tail = {0.06f, 1.3f, -0.03f}, .Radius = 0.1f},
+            {.Offset = {-0.05f, 1.12f, 0.0f}, .Tail = {0.05f, 1.12f, 0.0f}, .Radius = 0.11f},
+            {.Offset = {-0.08f, 0.95f, 0.0f}, .Tail = {0.08f, 0.95f, 0.0f}, .Radius = 0.12f},
+            {.Offset = {-0.1f, 0.9f, 0.0f}, .Tail = {-0.1f, 0.5f, 0.0f}, .Radius = 0.07f},
+            {.Offset = {0.1f, 0.9f, 0.0f}, .Tail = {0.1f, 0.5f, 0.0f}, .Radius = 0.07f},
+        };
+        for (auto collider : colliders) {
+          collider.Node = state->Root;
+          solverCI.Colliders.push_back(collider);
+        }
+
+        auto solver = SpringBoneSolver::Create(solverCI);
+        if (!solver)
+          return YK_RESULT_FAILURE(solver.error());
+        state->Solver = std::move(*solver);
+        return YK_RESULT_SUCCESS({});
+      },
+      .Update = [state](double time) {
+        auto &hierarchy = *state->Hierarchy;
+        const float turn = 0.6f * static_cast<float>(std::sin(time * 1.7));
+        hierarchy.SetLocal(state->Root, {0.1f * static_cast<float>(std::sin(time * 2.3)), 0.0f, 0.0f},
+                           {0.0f, std::sin(turn * 0.5f), 0.0f, std::cos(turn * 0.5f)}, {1.0f, 1.0f, 1.0f});
+        hierarchy.Update();
+        state->Solver->Update(FIXED_TIMESTEP);
+        hierarchy.Update();
+      },
+  };
+}
+
+// =====================
+// Scene Set
+// =====================
+std::vector<Scene> GetScenes() {
+  return {
+      {
+          .Name = "empty",
+          .Load = []() -> Result<> { return YK_RESULT_SUCCESS({}); },
+          .Update = [](double) {},
+      },
+      MakeTransformsScene(),
+      MakeCullingScene(),
+      MakeSpringBonesScene(),
+  };
+}
+
+} // namespace york::bench
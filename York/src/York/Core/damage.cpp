@@ -0,0 +1,68 @@
+#include "York/Core/damage.hpp"
+#include <algorithm>
+
+namespace york {
+
+static bool Intersects(const Rect &a, const Rect &b) noexcept {
+  return a.X < b.Right() && b.X < a.Right() && a.Y < b.Bottom() && b.Y < a.Bottom();
+}
+
+static bool Contains(const Rect &outer, const Rect &inner) noexcept {
+  return inner.X >= outer.X && inner.Y >= outer.Y && inner.Right() <= outer.Right() && inner.Bottom() <= outer.Bottom();
+}
+
+static Rect Union(const Rect &a, const Rect &b) noexcept {
+  const int32_t x = std::min(a.X, b.X);
+  const int32_t y = std::min(a.Y, b.Y);
+  return {x, y, static_cast<uint32_t>(std::max(a.Right(), b.Right()) - x), static_cast<uint32_t>(std::max(a.Bottom(), b.Bottom()) - y)};
+}
+
+// A resize invalidates everything that was tracked against the old extent
+void DamageTracker::SetExtent(uint32_t width, uint32_t height) noexcept {
+  if (width == m_Width && height == m_Height)
+    return;
+
+  m_Width = width;
+  m_Height = height;
+  m_Rects.assign(1, {0, 0, width, height});
+}
+
+bool DamageTracker::IsFull() const noexcept {
+  return m_Rects.size() == 1 && Contains(m_Rects[0], {0, 0, m_Width, m_Height});
+}
+
+void DamageTracker::Add(const Rect &rect) {
+  // Clip to the surface
+  const int32_t x = std::max(rect.X, 0);
+  const int32_t y = std::max(rect.Y, 0);
+  const int32_t right = std::min(rect.Right(), static_cast<int32_t>(m_Width));
+  const int32_t bottom = std::min(rect.Bottom(), static_cast<int32_t>(m_Height));
+  if (right <= x || bottom <= y)
+    return;
+
+  Rect merged{x, y, static_cast<uint32_t>(right - x), static_cast<uint32_t>(bottom - y)};
+  if (std::any_of(m_Rects.begin(), m_Rects.end(), [&](const Rect &r) { return Contains(r, merged); }))
+    return;
+
+  // Growing the rect can make it overlap rects that were checked before, repeat until stable
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto it = m_Rects.begin(); it != m_Rects.end(); ++it) {
+      if (!Intersects(*it, merged))
+        continue;
+      merged = Union(*it, merged);
+      m_Rects.erase(it);
+      changed = true;
+      break;
+    }
+  }
+
+  m_Rects.push_back(merged);
+  if (m_Rects.size() > MAX_RECTS) {
+    Rect bounds = m_Rects[0];
+    for (const auto &r : m_Rects)
+      bounds = Union(bounds, r);
+    m_Rects.assign(1, bounds);
+  }
+}
+} // namespace york
@@ -0,0 +1,55 @@
+#pragma once
+
+/*
+ * Surface Damage Tracking
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace york {
+
+// Buffer-space rectangle, origin top-left
+struct Rect {
+  int32_t X = 0;
+  int32_t Y = 0;
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+
+  bool IsEmpty() const noexcept { return Width == 0 || Height == 0; }
+  int32_t Right() const noexcept { return X + static_cast<int32_t>(Width); }
+  int32_t Bottom() const noexcept { return Y + static_cast<int32_t>(Height); }
+};
+
+// Size in pixels, e.g. of a surface or a render target
+struct Extent {
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+
+  bool operator==(const Extent &) const = default;
+};
+
+// Accumulates the regions changed since the last present
+// Overlapping rects are merged, past MAX_RECTS everything collapses into one bounding rect
+// An empty tracker means the surface is unchanged and the frame can be skipped entirely
+class DamageTracker {
+public:
+  static constexpr size_t MAX_RECTS = 16;
+
+  void SetExtent(uint32_t width, uint32_t height) noexcept;
+
+  void Add(const Rect &rect);
+  void AddFull() { Add({0, 0, m_Width, m_Height}); }
+  void Clear() noexcept { m_Rects.clear(); }
+
+  bool IsEmpty() const noexcept { return m_Rects.empty(); }
+  bool IsFull() const noexcept;
+  const std::vector<Rect> &GetRects() const noexcept { return m_Rects; }
+
+private:
+  uint32_t m_Width = 0;
+  uint32_t m_Height = 0;
+  std::vector<Rect> m_Rects;
+};
+} // namespace york
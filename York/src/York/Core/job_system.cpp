@@ -0,0 +1,124 @@
+#include "York/Core/job_system.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
+#include <algorithm>
+#include <format>
+#include <system_error>
+
+namespace york {
+
+// =====================
+// Pool Creation
+// =====================
+Result<std::unique_ptr<JobSystem>> JobSystem::Create(const JobSystemCreateInfo &createInfo) {
+  auto jobs = std::unique_ptr<JobSystem>(new JobSystem());
+
+  uint32_t count = createInfo.ThreadCount;
+  if (count == 0)
+    count = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+
+  try {
+    for (uint32_t i(0); i < count; ++i)
+      jobs->m_Threads.emplace_back(&JobSystem::WorkerLoop, jobs.get(), i);
+  } catch (const std::system_error &e) {
+    return YK_RESULT_FAILURE(Error::Create(std::format("Failed to start job worker: {}", e.what())));
+  }
+
+  return YK_RESULT_SUCCESS(jobs);
+}
+
+// =====================
+// Scheduling
+// =====================
+void JobSystem::Submit(Job job, JobCounter *counter) {
+  if (counter)
+    counter->Pending.fetch_add(1, std::memory_order_relaxed);
+
+  {
+    std::lock_guard lock(m_Mutex);
+    m_Queue.push_back({std::move(job), counter});
+  }
+  m_Wake.notify_one();
+}
+
+bool JobSystem::TryRunOne() {
+  QueuedJob job;
+  {
+    std::lock_guard lock(m_Mutex);
+    if (m_Queue.empty())
+      return false;
+    job = std::move(m_Queue.front());
+    m_Queue.pop_front();
+  }
+
+  job.Function();
+  if (job.Counter)
+    job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+void JobSystem::Wait(JobCounter &counter) {
+  YK_PROFILE_FUNCTION();
+  while (!counter.IsDone()) {
+    if (!TryRunOne())
+      std::this_thread::yield();
+  }
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t minBatch, const std::function<void(uint32_t begin, uint32_t end)> &fn) {
+  if (count == 0)
+    return;
+
+  // One batch per thread (caller included), never smaller than minBatch
+  const uint32_t workers = GetThreadCount() + 1;
+  const uint32_t batch = std::max({minBatch, (count + workers - 1) / workers, 1U});
+  if (batch >= count) {
+    fn(0, count);
+    return;
+  }
+
+  JobCounter counter;
+  for (uint32_t begin = batch; begin < count; begin += batch) {
+    const uint32_t end = std::min(begin + batch, count);
+    Submit([&fn, begin, end] { fn(begin, end); }, &counter);
+  }
+
+  fn(0, batch);
+  Wait(counter);
+}
+
+void JobSystem::WorkerLoop(uint32_t index) {
+  Profiler::SetThreadName(std::format("Job Worker {}", index));
+
+  while (true) {
+    QueuedJob job;
+    {
+      std::unique_lock lock(m_Mutex);
+      m_Wake.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+      if (m_Queue.empty())
+        return;
+      job = std::move(m_Queue.front());
+      m_Queue.pop_front();
+    }
+
+    job.Function();
+    if (job.Counter)
+      job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+// =====================
+// Destructor
+// =====================
+// Queued jobs are drained before the workers exit
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_Wake.notify_all();
+
+  for (auto &thread : m_Threads)
+    thread.join();
+}
+} // namespace york
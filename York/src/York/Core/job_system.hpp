@@ -0,0 +1,76 @@
+#pragma once
+
+/*
+ * Worker Thread Pool
+ */
+
+#include "York/Core/result.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace york {
+
+// ThreadCount 0 uses every hardware thread but the calling one
+struct JobSystemCreateInfo {
+  uint32_t ThreadCount = 0;
+};
+
+// Tracks a group of submitted jobs, must outlive them
+struct JobCounter {
+  std::atomic<uint32_t> Pending = 0;
+
+  bool IsDone() const noexcept { return Pending.load(std::memory_order_acquire) == 0; }
+};
+
+// Usage:
+// JobCounter counter; jobs->Submit([] { ... }, &counter); jobs->Wait(counter);
+// jobs->ParallelFor(count, 64, [&](uint32_t begin, uint32_t end) { ... });
+// Waiting threads run queued jobs instead of sleeping, so jobs may submit and wait on nested jobs
+class JobSystem {
+public:
+  using Job = std::function<void()>;
+
+  static Result<std::unique_ptr<JobSystem>> Create(const JobSystemCreateInfo &createInfo = {});
+
+public:
+  void Submit(Job job, JobCounter *counter = nullptr);
+  void Wait(JobCounter &counter);
+
+  // Splits [0, count) into batches of at least minBatch items, the caller runs one of them
+  // Runs inline when the range fits in a single batch
+  void ParallelFor(uint32_t count, uint32_t minBatch, const std::function<void(uint32_t begin, uint32_t end)> &fn);
+
+  uint32_t GetThreadCount() const noexcept { return static_cast<uint32_t>(m_Threads.size()); }
+
+private:
+  JobSystem() = default;
+
+  void WorkerLoop(uint32_t index);
+  bool TryRunOne();
+
+public:
+  ~JobSystem();
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+private:
+  struct QueuedJob {
+    Job Function;
+    JobCounter *Counter = nullptr;
+  };
+
+private:
+  std::vector<std::thread> m_Threads;
+  std::mutex m_Mutex;
+  std::condition_variable m_Wake;
+  std::deque<QueuedJob> m_Queue;
+  bool m_Stop = false;
+};
+} // namespace york
@@ -0,0 +1,280 @@
+#include "York/Core/profiler.hpp"
+#include "York/Core/error.hpp"
+#include <algorithm>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace york {
+std::atomic<bool> Profiler::s_Enabled = false;
+uint64_t Profiler::s_FrameIndex = 0;
+
+// Track IDs in the exported trace, recording threads start after them
+static constexpr uint32_t FRAME_TRACK_ID = 0;
+static constexpr uint32_t GPU_TRACK_ID = 1;
+
+// Every thread records into its own buffer, the mutex is only contended while EndFrame gathers
+struct ThreadBuffer {
+  std::mutex Mutex;
+  uint32_t ID = 0;
+  std::string Name;
+  std::vector<ProfileZone> Open;
+  std::vector<ProfileZone> Closed;
+};
+
+static std::mutex g_RegistryMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> g_Threads;
+static uint32_t g_NextThreadID = GPU_TRACK_ID + 1;
+
+static std::mutex g_HistoryMutex;
+static std::deque<ProfilerFrame> g_History;
+static ProfilerFrame g_Current;
+static std::atomic<uint64_t> g_PresentWait = 0;
+
+static ThreadBuffer &GetThreadBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto created = std::make_shared<ThreadBuffer>();
+    std::lock_guard lock(g_RegistryMutex);
+    created->ID = g_NextThreadID++;
+    created->Name = std::format("Thread {}", created->ID);
+    g_Threads.emplace_back(created);
+    return created;
+  }();
+  return *buffer;
+}
+
+// =====================
+// Recording
+// =====================
+void Profiler::SetThreadName(std::string_view name) {
+  auto &buffer = GetThreadBuffer();
+  std::lock_guard lock(buffer.Mutex);
+  buffer.Name = name;
+}
+
+void Profiler::BeginZone(const char *name) {
+  auto &buffer = GetThreadBuffer();
+  std::lock_guard lock(buffer.Mutex);
+  buffer.Open.push_back({
+      .Name = name,
+      .Begin = Now(),
+      .ThreadID = buffer.ID,
+      .Depth = static_cast<uint32_t>(buffer.Open.size()),
+  });
+}
+
+void Profiler::EndZone() {
+  auto &buffer = GetThreadBuffer();
+  std::lock_guard lock(buffer.Mutex);
+  // The profiler may have been enabled while this zone was already running
+  if (buffer.Open.empty())
+    return;
+
+  ProfileZone zone = buffer.Open.back();
+  buffer.Open.pop_back();
+  zone.End = Now();
+  buffer.Closed.emplace_back(zone);
+}
+
+void Profiler::AddPresentWait(uint64_t nanoseconds) {
+  if (IsEnabled())
+    g_PresentWait.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void Profiler::BeginFrame() {
+  if (!IsEnabled())
+    return;
+
+  g_Current = {.Index = s_FrameIndex, .Begin = Now()};
+  g_PresentWait.store(0, std::memory_order_relaxed);
+}
+
+void Profiler::EndFrame() {
+  if (!IsEnabled())
+    return;
+
+  g_Current.End = Now();
+  g_Current.PresentWait = g_PresentWait.exchange(0, std::memory_order_relaxed);
+
+  {
+    std::lock_guard registry(g_RegistryMutex);
+    for (auto &thread : g_Threads) {
+      std::lock_guard lock(thread->Mutex);
+      g_Current.Zones.insert(g_Current.Zones.end(), thread->Closed.begin(), thread->Closed.end());
+      thread->Closed.clear();
+    }
+  }
+
+  std::lock_guard lock(g_HistoryMutex);
+  g_History.emplace_back(std::move(g_Current));
+  while (g_History.size() > HISTORY_SIZE)
+    g_History.pop_front();
+
+  g_Current = {};
+  s_FrameIndex++;
+}
+
+void Profiler::SubmitGPUZones(uint64_t frameIndex, const std::vector<GPUProfileZone> &zones) {
+  if (!IsEnabled())
+    return;
+
+  std::lock_guard lock(g_HistoryMutex);
+  auto frame = std::find_if(g_History.rbegin(), g_History.rend(), [&](const ProfilerFrame &f) { return f.Index == frameIndex; });
+  if (frame != g_History.rend()) {
+    frame->GPUZones.insert(frame->GPUZones.end(), zones.begin(), zones.end());
+    frame->HasGPU = true;
+  }
+}
+
+// =====================
+// Summaries
+// =====================
+FrameSummary Profiler::Summarize(const ProfilerFrame &frame) {
+  FrameSummary summary{
+      .FrameIndex = frame.Index,
+      .CPUMs = static_cast<double>(frame.End - frame.Begin) / 1e6,
+      .PresentWaitMs = static_cast<double>(frame.PresentWait) / 1e6,
+      .HasGPU = frame.HasGPU,
+  };
+
+  uint64_t gpuBegin = UINT64_MAX, gpuEnd = 0;
+  for (const auto &zone : frame.GPUZones) {
+    if (zone.Depth != 0)
+      continue;
+    gpuBegin = std::min(gpuBegin, zone.Begin);
+    gpuEnd = std::max(gpuEnd, zone.End);
+    summary.Passes.push_back({zone.Name, static_cast<double>(zone.End - zone.Begin) / 1e6});
+  }
+  if (gpuEnd > gpuBegin)
+    summary.GPUMs = static_cast<double>(gpuEnd - gpuBegin) / 1e6;
+
+  return summary;
+}
+
+FrameSummary Profiler::GetLatestSummary() {
+  std::lock_guard lock(g_HistoryMutex);
+  if (g_History.empty())
+    return {};
+
+  auto frame = std::find_if(g_History.rbegin(), g_History.rend(), [](const ProfilerFrame &f) { return f.HasGPU; });
+  return Summarize(frame != g_History.rend() ? *frame : g_History.back());
+}
+
+FrameSummary Profiler::GetRollingSummary(size_t frames) {
+  std::lock_guard lock(g_HistoryMutex);
+  frames = std::min(frames, g_History.size());
+  if (frames == 0)
+    return {};
+
+  FrameSummary average{.FrameIndex = g_History.back().Index};
+  uint32_t gpuFrames = 0;
+  for (auto it = g_History.end() - static_cast<std::ptrdiff_t>(frames); it != g_History.end(); ++it) {
+    auto summary = Summarize(*it);
+    average.CPUMs += summary.CPUMs;
+    average.PresentWaitMs += summary.PresentWaitMs;
+
+    // The newest frames are still waiting for their GPU results
+    if (!summary.HasGPU)
+      continue;
+    gpuFrames++;
+    average.GPUMs += summary.GPUMs;
+
+    for (const auto &pass : summary.Passes) {
+      auto found = std::find_if(average.Passes.begin(), average.Passes.end(),
+                                [&](const PassTiming &p) { return std::string_view(p.Name) == pass.Name; });
+      if (found == average.Passes.end())
+        average.Passes.push_back(pass);
+      else
+        found->Milliseconds += pass.Milliseconds;
+    }
+  }
+
+  const double count = static_cast<double>(frames);
+  average.CPUMs /= count;
+  average.PresentWaitMs /= count;
+
+  if (gpuFrames > 0) {
+    const double gpuCount = static_cast<double>(gpuFrames);
+    average.GPUMs /= gpuCount;
+    average.HasGPU = true;
+    for (auto &pass : average.Passes)
+      pass.Milliseconds /= gpuCount;
+  }
+
+  return average;
+}
+
+// =====================
+// Chrome Trace Export
+// =====================
+static std::string EscapeJSON(std::string_view str) {
+  std::string result;
+  result.reserve(str.size());
+  for (char c : str) {
+    // clang-format off
+    switch (c) {
+    case '"':  result += "\\\""; break;
+    case '\\': result += "\\\\"; break;
+    case '\n': result += "\\n";  break;
+    case '\t': result += "\\t";  break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        result += std::format("\\u{:04x}", static_cast<unsigned>(c));
+      else
+        result += c;
+    }
+    // clang-format on
+  }
+  return result;
+}
+
+static void WriteEvent(std::ofstream &out, bool &first, std::string_view name, uint32_t tid, uint64_t begin, uint64_t end) {
+  out << (first ? "\n" : ",\n");
+  first = false;
+  // Trace timestamps are in microseconds
+  out << std::format(R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                     EscapeJSON(name), tid, static_cast<double>(begin) / 1e3, static_cast<double>(end - begin) / 1e3);
+}
+
+static void WriteThreadName(std::ofstream &out, bool &first, std::string_view name, uint32_t tid) {
+  out << (first ? "\n" : ",\n");
+  first = false;
+  out << std::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})", tid, EscapeJSON(name));
+}
+
+Result<> Profiler::ExportChromeTrace(const std::string &path) {
+  std::ofstream out(path, std::ios::trunc);
+  if (!out)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Failed to open trace file: {}", path)));
+
+  bool first = true;
+  out << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+  WriteThreadName(out, first, "Frames", FRAME_TRACK_ID);
+  WriteThreadName(out, first, "GPU", GPU_TRACK_ID);
+  {
+    std::lock_guard lock(g_RegistryMutex);
+    for (const auto &thread : g_Threads) {
+      std::lock_guard threadLock(thread->Mutex);
+      WriteThreadName(out, first, thread->Name, thread->ID);
+    }
+  }
+
+  std::lock_guard lock(g_HistoryMutex);
+  for (const auto &frame : g_History) {
+    WriteEvent(out, first, std::format("Frame {}", frame.Index), FRAME_TRACK_ID, frame.Begin, frame.End);
+    for (const auto &zone : frame.Zones)
+      WriteEvent(out, first, zone.Name, zone.ThreadID, zone.Begin, zone.End);
+    for (const auto &zone : frame.GPUZones)
+      WriteEvent(out, first, zone.Name, GPU_TRACK_ID, zone.Begin, zone.End);
+  }
+
+  out << "\n]}\n";
+  if (!out)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Failed to write trace file: {}", path)));
+
+  return YK_RESULT_SUCCESS({});
+}
+} // namespace york
@@ -0,0 +1,147 @@
+#pragma once
+
+/*
+ * CPU/GPU Frame Profiler
+ */
+
+#include "York/Core/result.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace york {
+
+// Single closed zone, timestamps are nanoseconds on the steady (CLOCK_MONOTONIC) clock
+struct ProfileZone {
+  const char *Name = nullptr;
+  uint64_t Begin = 0;
+  uint64_t End = 0;
+  uint32_t ThreadID = 0;
+  uint32_t Depth = 0;
+};
+
+// GPU zones are already converted to the CPU clock by vulkan::GPUProfiler
+// Name must outlive the frame history (string literals)
+struct GPUProfileZone {
+  const char *Name = nullptr;
+  uint64_t Begin = 0;
+  uint64_t End = 0;
+  uint32_t Depth = 0;
+};
+
+struct PassTiming {
+  const char *Name = nullptr;
+  double Milliseconds = 0.0;
+};
+
+// Per-frame numbers the application can read back
+// GPUMs is the span of all top-level GPU zones, Passes holds each top-level GPU zone
+// HasGPU is false until GPU zones were submitted, GPUMs and Passes are then empty
+struct FrameSummary {
+  uint64_t FrameIndex = 0;
+  double CPUMs = 0.0;
+  double GPUMs = 0.0;
+  double PresentWaitMs = 0.0;
+  bool HasGPU = false;
+  std::vector<PassTiming> Passes;
+};
+
+struct ProfilerFrame {
+  uint64_t Index = 0;
+  uint64_t Begin = 0;
+  uint64_t End = 0;
+  uint64_t PresentWait = 0;
+  bool HasGPU = false;
+  std::vector<ProfileZone> Zones;
+  std::vector<GPUProfileZone> GPUZones;
+};
+
+// Usage:
+// Profiler::SetEnabled(true) once at startup
+// Profiler::BeginFrame() / Profiler::EndFrame() around every frame on the main thread
+// YK_PROFILE_SCOPE("Name") in any function on any thread
+// Zones are buffered per thread and gathered on EndFrame, the last HISTORY_SIZE frames are kept
+class Profiler {
+public:
+  static constexpr size_t HISTORY_SIZE = 240;
+
+  static uint64_t Now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+  }
+
+  static bool IsEnabled() noexcept { return s_Enabled.load(std::memory_order_relaxed); }
+  static void SetEnabled(bool enabled) noexcept { s_Enabled.store(enabled, std::memory_order_relaxed); }
+
+  // Thread name shows up in the exported trace, otherwise "Thread <id>"
+  static void SetThreadName(std::string_view name);
+
+  static void BeginFrame();
+  static void EndFrame();
+
+  static void BeginZone(const char *name);
+  static void EndZone();
+
+  // Accumulated into the current frame, reported as PresentWaitMs
+  static void AddPresentWait(uint64_t nanoseconds);
+
+  // GPU results arrive a few frames late, they are attached to the frame they were recorded in
+  static void SubmitGPUZones(uint64_t frameIndex, const std::vector<GPUProfileZone> &zones);
+
+  static uint64_t GetFrameIndex() noexcept { return s_FrameIndex; }
+  // Newest frame whose GPU zones were collected, a few frames behind the CPU
+  // Falls back to the newest frame when no GPU zones were ever submitted
+  static FrameSummary GetLatestSummary();
+  // Average over the last 'frames' completed frames, Passes are matched by name
+  // GPUMs and Passes only average the frames whose GPU zones were collected
+  static FrameSummary GetRollingSummary(size_t frames = 60);
+
+  // Chrome trace / Perfetto JSON of the whole history
+  static Result<> ExportChromeTrace(const std::string &path);
+
+private:
+  static FrameSummary Summarize(const ProfilerFrame &frame);
+
+private:
+  static std::atomic<bool> s_Enabled;
+  static uint64_t s_FrameIndex;
+};
+
+// RAII Zone, skips recording when the profiler is disabled at runtime
+class ProfileScope {
+public:
+  explicit ProfileScope(const char *name) noexcept : m_Active(Profiler::IsEnabled()) {
+    if (m_Active)
+      Profiler::BeginZone(name);
+  }
+  ~ProfileScope() {
+    if (m_Active)
+      Profiler::EndZone();
+  }
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  bool m_Active;
+};
+} // namespace york
+
+// Zones compile out entirely unless YORK_ENABLE_PROFILER is defined (CMake option YORK_PROFILER)
+#define YK_PROFILE_CONCAT_IMPL(a, b) a##b
+#define YK_PROFILE_CONCAT(a, b) YK_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef YORK_ENABLE_PROFILER
+#define YK_PROFILE_SCOPE(name) ::york::ProfileScope YK_PROFILE_CONCAT(_ykProfileScope, __LINE__)(name)
+#define YK_PROFILE_FUNCTION() YK_PROFILE_SCOPE(__func__)
+#define YK_PROFILE_FRAME_BEGIN() ::york::Profiler::BeginFrame()
+#define YK_PROFILE_FRAME_END() ::york::Profiler::EndFrame()
+#else
+#define YK_PROFILE_SCOPE(name)
+#define YK_PROFILE_FUNCTION()
+#define YK_PROFILE_FRAME_BEGIN()
+#define YK_PROFILE_FRAME_END()
+#endif
@@ -0,0 +1,49 @@
+#include "York/Core/resolution_scaler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace york {
+
+// Weight of the newest sample in the GPU time average, smooths single-frame spikes
+static constexpr double AVERAGE_WEIGHT = 0.1;
+
+ResolutionScaler::ResolutionScaler(const ResolutionScalerCreateInfo &createInfo)
+    : m_CreateInfo(createInfo), m_Scale(createInfo.MaxScale) {}
+
+float ResolutionScaler::Snap(float scale) const noexcept {
+  const float step = std::max(m_CreateInfo.Step, 0.01f);
+  return std::clamp(std::floor(scale / step + 0.5f) * step, m_CreateInfo.MinScale, m_CreateInfo.MaxScale);
+}
+
+float ResolutionScaler::Update(double gpuMs) {
+  if (gpuMs <= 0.0)
+    return m_Scale;
+
+  m_AverageMs = m_AverageMs == 0.0 ? gpuMs : m_AverageMs + (gpuMs - m_AverageMs) * AVERAGE_WEIGHT;
+  m_FramesSinceChange++;
+
+  // Give the new resolution a few frames to show up in the timings before reacting again
+  if (m_FramesSinceChange < m_CreateInfo.CooldownFrames)
+    return m_Scale;
+
+  float next = m_Scale;
+  if (m_AverageMs > m_CreateInfo.TargetFrameMs)
+    next = Snap(m_Scale * static_cast<float>(std::sqrt(m_CreateInfo.TargetFrameMs / m_AverageMs)) - m_CreateInfo.Step * 0.5f);
+  else if (m_AverageMs < m_CreateInfo.TargetFrameMs * m_CreateInfo.Headroom)
+    next = Snap(m_Scale + m_CreateInfo.Step);
+
+  if (next != m_Scale) {
+    m_Scale = next;
+    m_FramesSinceChange = 0;
+  }
+  return m_Scale;
+}
+
+Extent ResolutionScaler::ComputeExtent(uint32_t logicalWidth, uint32_t logicalHeight, float outputScale) const noexcept {
+  const float scale = m_Scale * outputScale;
+  return {
+      .Width = std::max(1U, static_cast<uint32_t>(std::lround(static_cast<float>(logicalWidth) * scale))),
+      .Height = std::max(1U, static_cast<uint32_t>(std::lround(static_cast<float>(logicalHeight) * scale))),
+  };
+}
+} // namespace york
@@ -0,0 +1,48 @@
+#pragma once
+
+/*
+ * Dynamic Resolution Controller
+ */
+
+#include "York/Core/damage.hpp"
+#include <cstdint>
+
+namespace york {
+
+// TargetFrameMs is the GPU budget per frame
+// Scales are fractions of the native pixel extent (logical size * output scale)
+// Headroom: the scale only grows back while GPU time stays under TargetFrameMs * Headroom
+struct ResolutionScalerCreateInfo {
+  double TargetFrameMs = 1000.0 / 60.0;
+  float MinScale = 0.5f;
+  float MaxScale = 1.0f;
+  float Step = 0.05f;
+  double Headroom = 0.85;
+  uint32_t CooldownFrames = 30;
+};
+
+// Watches GPU frame time and picks the internal render scale
+// Drops quickly when over budget (pixel cost grows with scale squared), grows back one Step at a time
+// Scales are snapped to multiples of Step so the render targets are not recreated every frame
+class ResolutionScaler {
+public:
+  explicit ResolutionScaler(const ResolutionScalerCreateInfo &createInfo = {});
+
+  // gpuMs <= 0 (no GPU timing this frame) keeps the current scale
+  float Update(double gpuMs);
+
+  float GetScale() const noexcept { return m_Scale; }
+
+  // Render extent for a surface of the given logical size on an output with the given (fractional) scale
+  Extent ComputeExtent(uint32_t logicalWidth, uint32_t logicalHeight, float outputScale) const noexcept;
+
+private:
+  float Snap(float scale) const noexcept;
+
+private:
+  ResolutionScalerCreateInfo m_CreateInfo;
+  float m_Scale;
+  double m_AverageMs = 0.0;
+  uint32_t m_FramesSinceChange = 0;
+};
+} // namespace york
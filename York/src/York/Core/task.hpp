@@ -0,0 +1,150 @@
+#pragma once
+
+/*
+ * Coroutine Tasks on the Job System
+ */
+
+#include "York/Core/job_system.hpp"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace york {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+// Resumes whoever awaited the task, tasks awaited by nobody (Spawn) are destroyed by their wrapper
+struct TaskFinalAwaiter {
+  bool await_ready() const noexcept { return false; }
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+    if (auto continuation = handle.promise().Continuation)
+      return continuation;
+    return std::noop_coroutine();
+  }
+  void await_resume() const noexcept {}
+};
+
+struct TaskPromiseBase {
+  std::coroutine_handle<> Continuation;
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+  // York reports errors through Result, an escaping exception is a bug
+  void unhandled_exception() const noexcept { std::terminate(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+  std::optional<T> Value;
+
+  Task<T> get_return_object() noexcept;
+  void return_value(T value) { Value.emplace(std::move(value)); }
+  T TakeValue() { return std::move(*Value); }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+  Task<void> get_return_object() noexcept;
+  void return_void() const noexcept {}
+  void TakeValue() const noexcept {}
+};
+
+// Top level coroutine of Spawn, frees itself when done
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() noexcept { return {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+
+  std::coroutine_handle<promise_type> Handle;
+};
+} // namespace detail
+
+// Lazy coroutine, starts when awaited and resumes its awaiter when done (symmetric transfer, no stack growth)
+// Usage:
+// Task<Result<Mesh>> LoadMesh(io::Context &io, std::string path) { auto bytes = co_await io::ReadFile(io, path); ... co_return mesh; }
+// Spawn(*jobs, LoadScene(...), &counter); jobs->Wait(counter);
+template <typename T>
+class Task {
+public:
+  using promise_type = detail::TaskPromise<T>;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : m_Handle(handle) {}
+  Task(Task &&other) noexcept : m_Handle(std::exchange(other.m_Handle, nullptr)) {}
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (m_Handle)
+        m_Handle.destroy();
+      m_Handle = std::exchange(other.m_Handle, nullptr);
+    }
+    return *this;
+  }
+  ~Task() {
+    if (m_Handle)
+      m_Handle.destroy();
+  }
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+public:
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> Handle;
+
+      bool await_ready() const noexcept { return false; }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        Handle.promise().Continuation = awaiter;
+        return Handle;
+      }
+      T await_resume() { return Handle.promise().TakeValue(); }
+    };
+    return Awaiter{m_Handle};
+  }
+
+private:
+  std::coroutine_handle<promise_type> m_Handle;
+};
+
+template <typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+// co_await ResumeOn(jobs) continues the coroutine on a job worker, e.g. to decode off the I/O completion path
+inline auto ResumeOn(JobSystem &jobs) noexcept {
+  struct Awaiter {
+    JobSystem &Jobs;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const { Jobs.Submit([handle] { handle.resume(); }); }
+    void await_resume() const noexcept {}
+  };
+  return Awaiter{jobs};
+}
+
+// Starts task on a job worker without awaiting it, counter (optional) stays pending until the task finished
+// JobSystem::Wait(counter) runs jobs meanwhile, including the continuations of the task
+inline void Spawn(JobSystem &jobs, Task<void> task, JobCounter *counter = nullptr) {
+  if (counter)
+    counter->Pending.fetch_add(1, std::memory_order_relaxed);
+
+  auto detached = [](Task<void> task, JobCounter *counter) -> detail::DetachedTask {
+    co_await std::move(task);
+    if (counter)
+      counter->Pending.fetch_sub(1, std::memory_order_release);
+  }(std::move(task), counter);
+
+  jobs.Submit([handle = detached.Handle] { handle.resume(); });
+}
+} // namespace york
@@ -1,23 +1,50 @@
 #pragma once
 
+#include "York/Core/damage.hpp"
 #include "York/Core/result.hpp"
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace york {
 // Usage:
 // using HandleType = <Window Handle Type>
 // using LayerType = <Layered Window Type or std::nullptr_t>
+// using FrameCallbackType = <Compositor Frame Callback Type or std::nullptr_t>
+// using ViewportType = <Surface Scaling Type or std::nullptr_t>
+// using FractionalScaleType = <Preferred Scale Notifier Type or std::nullptr_t>
 // constexpr VK_SURFACE_EXTENSION_NAME = '<Vulkan Surface Extension name>'
-// VkSurface CreateSurface(HandleType handle, VkInstance instance)
+// constexpr SURFACE_OPTIONAL = <true when the Instance may be created without the surface extensions>
+// VkSurface CreateSurface(const vulkan::Instance &instance, HandleType handle), through the instance dispatch table
 template <class Platform>
 struct PlatformTraits;
 
+// Display output as reported by the platform, RefreshMilliHz is 0 when unknown
+struct OutputInfo {
+  uint32_t ID = 0;
+  std::string Name;
+  std::string Description;
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  uint32_t RefreshMilliHz = 0;
+  float Scale = 1.0f;
+};
+
+// Output is an OutputInfo::ID from Window::EnumerateOutputs, the platform picks one when empty
 struct WindowCreateInfo {
   std::string Title;
   uint32_t Width = 0;
   uint32_t Height = 0;
-  bool IsLayer;
+  bool IsLayer = false;
+  std::optional<uint32_t> Output;
+};
+
+// Written by platform listeners, Closed is set when the compositor withdraws the surface (e.g. its output is gone)
+struct SurfaceState {
+  bool Configured = false;
+  bool Closed = false;
 };
 
 // Example of Definition of Platform: { class Windows; } & { class Wayland; }
@@ -28,10 +55,23 @@ public:
   static uint32_t s_WindowCount;
   using HandleType = typename PlatformTraits<Platform>::HandleType;
   using LayerType = typename PlatformTraits<Platform>::LayerType;
+  using FrameCallbackType = typename PlatformTraits<Platform>::FrameCallbackType;
+  using ViewportType = typename PlatformTraits<Platform>::ViewportType;
+  using FractionalScaleType = typename PlatformTraits<Platform>::FractionalScaleType;
 
 public:
   static Result<std::unique_ptr<Window>> Create(const WindowCreateInfo &ci);
 
+  // Connects to the platform if needed, outputs are tracked as they are added or removed
+  // May be empty (e.g. lid closed), outputs plugged in later are listed once DispatchEvents received them
+  static Result<std::vector<OutputInfo>> EnumerateOutputs();
+
+  // Dispatches events of every window, waits at most timeoutMs for new ones
+  // Multi-window loops call it once per tick, each window stays paced by its own frame callbacks
+  // The wait is reported as present wait only while a window waits on a frame callback, idle ticks are not
+  // Fails once the connection to the platform is lost, no window can present after that
+  static Result<> DispatchEvents(uint32_t timeoutMs);
+
 private:
   Window<Platform>() = default;
 
@@ -43,11 +83,49 @@ public:
   Window<Platform>(const Window<Platform> &) = delete;
   Window<Platform> &operator=(const Window<Platform> &) = delete;
 
-  void Frame() const;
+  // Commits pending damage when the compositor is ready for it, does nothing otherwise
+  void Present();
+
+  // Single window loop: Present, then wait for events
+  // Without damage nothing is committed and the call returns after at most the idle tick
+  Result<> Frame() {
+    Present();
+    return DispatchEvents(ShouldRender() ? 0 : m_IdleTickMs);
+  }
+
+  bool IsClosed() const noexcept { return m_State.Closed; }
+
+  void AddDamage(const Rect &rect) { m_Damage.Add(rect); }
+  void AddFullDamage() { m_Damage.AddFull(); }
+  void SetIdleTick(uint32_t milliseconds) noexcept { m_IdleTickMs = milliseconds; }
+
+  // False while idle or while the previous frame is still waiting on the compositor
+  bool ShouldRender() const noexcept { return !m_Damage.IsEmpty() && m_FrameCallback == nullptr; }
+  const DamageTracker &GetDamage() const noexcept { return m_Damage; }
+
+  // Size of the rendered buffer, the compositor scales it to the logical size
+  // Takes effect on the next commit, call it when the swapchain is recreated at that extent
+  // Returns false when the platform cannot scale, the buffer must then match the logical size
+  bool SetRenderExtent(const Extent &extent);
+  Extent GetRenderExtent() const noexcept { return m_RenderExtent; }
+
+  // Preferred output scale reported by the compositor (1.0 when unknown)
+  float GetScale() const noexcept { return m_Scale; }
+
+  HandleType Get() const noexcept { return m_Handle; }
+  const WindowCreateInfo &GetCreateInfo() const noexcept { return m_CreateInfo; }
 
 protected:
-  HandleType m_Handle;
+  HandleType m_Handle{};
   WindowCreateInfo m_CreateInfo;
-  LayerType m_Layer;
+  LayerType m_Layer{};
+  SurfaceState m_State;
+  FrameCallbackType m_FrameCallback{};
+  DamageTracker m_Damage;
+  uint32_t m_IdleTickMs = 250;
+  ViewportType m_Viewport{};
+  FractionalScaleType m_FractionalScale{};
+  Extent m_RenderExtent;
+  float m_Scale = 1.0f;
 };
 } // namespace york
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "York/Graphics/Vulkan/dispatch.hpp"
+#include <algorithm>
+#include <string_view>
+
+namespace york::vulkan {
+
+static bool Contains(std::span<const char *const> extensions, std::string_view name) noexcept {
+  return std::ranges::any_of(extensions, [&](const char *extension) { return name == extension; });
+}
+
+// =====================
+// Instance Dispatch
+// =====================
+void InstanceDispatch::Load(VkInstance instance, uint32_t apiVersion, std::span<const char *const> extensions) {
+  *this = {};
+  ApiVersion = apiVersion;
+  EnabledExtensions.assign(extensions.begin(), extensions.end());
+
+  // clang-format off
+#define YK_VK_LOAD(name, symbol) name = reinterpret_cast<PFN_vk##name>(vkGetInstanceProcAddr(instance, symbol))
+#define YK_VK_INSTANCE(name, version) if (apiVersion >= (version)) YK_VK_LOAD(name, "vk" #name);
+#define YK_VK_INSTANCE_EXTENSION(name, extension) if (Contains(extensions, extension)) YK_VK_LOAD(name, "vk" #name);
+#define YK_VK_INSTANCE_DEVICE_EXTENSION(name, extension) YK_VK_LOAD(name, "vk" #name);
+#include "York/Graphics/Vulkan/dispatch_table.inl"
+#undef YK_VK_LOAD
+  // clang-format on
+}
+
+bool InstanceDispatch::IsExtensionEnabled(const char *extension) const noexcept {
+  return std::ranges::find(EnabledExtensions, std::string_view(extension)) != EnabledExtensions.end();
+}
+
+// =====================
+// Device Dispatch
+// =====================
+void DeviceDispatch::Load(const InstanceDispatch &instance, VkDevice device, uint32_t apiVersion, std::span<const char *const> extensions) {
+  *this = {};
+  Instance = &instance;
+  Device = device;
+  ApiVersion = apiVersion;
+  EnabledExtensions.assign(extensions.begin(), extensions.end());
+
+  const auto getProcAddr = instance.GetDeviceProcAddr;
+  auto enabled = [&](const char *extension) { return Contains(extensions, extension) || instance.IsExtensionEnabled(extension); };
+
+  // clang-format off
+#define YK_VK_LOAD(name, symbol) name = reinterpret_cast<PFN_vk##name>(getProcAddr(device, symbol))
+#define YK_VK_DEVICE(name, version) if (apiVersion >= (version)) YK_VK_LOAD(name, "vk" #name);
+#define YK_VK_DEVICE_EXTENSION(name, extension) if (enabled(extension)) YK_VK_LOAD(name, "vk" #name);
+#define YK_VK_DEVICE_PROMOTED(name, version, alias, extension)                                                         \
+  if (apiVersion >= (version)) YK_VK_LOAD(name, "vk" #name);                                                           \
+  else if (enabled(extension)) YK_VK_LOAD(name, "vk" #alias);
+#include "York/Graphics/Vulkan/dispatch_table.inl"
+#undef YK_VK_LOAD
+  // clang-format on
+}
+
+bool DeviceDispatch::IsExtensionEnabled(const char *extension) const noexcept {
+  return std::ranges::find(EnabledExtensions, std::string_view(extension)) != EnabledExtensions.end();
+}
+} // namespace york::vulkan
@@ -0,0 +1,56 @@
+#pragma once
+
+/*
+ * Instance / Device Function Tables
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <vulkan/vulkan_wayland.h>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace york::vulkan {
+
+// Function pointers of one VkInstance, loaded once through vkGetInstanceProcAddr
+// Entries of a version above ApiVersion or of an extension that is not enabled stay nullptr
+// Usage: instance->GetDispatch().EnumeratePhysicalDevices(instance->Get(), &count, nullptr)
+struct InstanceDispatch {
+  uint32_t ApiVersion = 0;
+  std::vector<std::string> EnabledExtensions;
+
+#define YK_VK_INSTANCE(name, version) PFN_vk##name name = nullptr;
+#define YK_VK_INSTANCE_EXTENSION(name, extension) PFN_vk##name name = nullptr;
+#define YK_VK_INSTANCE_DEVICE_EXTENSION(name, extension) PFN_vk##name name = nullptr;
+#include "York/Graphics/Vulkan/dispatch_table.inl"
+
+  // apiVersion is VK_MAKE_API_VERSION encoded, extensions are the ones the instance was created with
+  void Load(VkInstance instance, uint32_t apiVersion, std::span<const char *const> extensions);
+
+  bool IsExtensionEnabled(const char *extension) const noexcept;
+};
+
+// Function pointers of one VkDevice, loaded once through vkGetDeviceProcAddr
+// Calls go straight to the driver instead of the loader trampoline, they are what command recording should use
+// Instance-level entries are reached through Instance, which must outlive the table
+// Usage: dispatch.CmdDraw(cmd, 3, 1, 0, 0)
+struct DeviceDispatch {
+  const InstanceDispatch *Instance = nullptr;
+  VkDevice Device = VK_NULL_HANDLE;
+  uint32_t ApiVersion = 0;
+  std::vector<std::string> EnabledExtensions;
+
+#define YK_VK_DEVICE(name, version) PFN_vk##name name = nullptr;
+#define YK_VK_DEVICE_EXTENSION(name, extension) PFN_vk##name name = nullptr;
+#define YK_VK_DEVICE_PROMOTED(name, version, alias, extension) PFN_vk##name name = nullptr;
+#include "York/Graphics/Vulkan/dispatch_table.inl"
+
+  // apiVersion is the version the device was created for (the lowest of the instance and physical device versions)
+  // extensions are the ones enabled on the device, instance extensions are taken from instance
+  void Load(const InstanceDispatch &instance, VkDevice device, uint32_t apiVersion, std::span<const char *const> extensions);
+
+  // Device extensions only, instance ones are on Instance
+  bool IsExtensionEnabled(const char *extension) const noexcept;
+};
+} // namespace york::vulkan
@@ -0,0 +1,167 @@
+/*
+ * Vulkan Dispatch Table
+ */
+
+// Single list InstanceDispatch and DeviceDispatch are generated from (members and loaders)
+// Names drop the vk prefix, versions are VK_API_VERSION_* and extensions are *_EXTENSION_NAME
+// Define the entries needed before including, the others expand to nothing and every entry is undefined at the end
+//
+// YK_VK_INSTANCE(Name, Version)                   instance level, core since Version
+// YK_VK_INSTANCE_EXTENSION(Name, Extension)       instance level, loaded when Extension is enabled on the Instance
+// YK_VK_INSTANCE_DEVICE_EXTENSION(Name, Extension) instance level command of a device extension, loaded when exposed,
+//                                                 callers check the physical device supports Extension
+// YK_VK_DEVICE(Name, Version)                     device level, core since Version
+// YK_VK_DEVICE_EXTENSION(Name, Extension)         device level, loaded when Extension is enabled on the Device or the Instance
+// YK_VK_DEVICE_PROMOTED(Name, Version, Alias, Extension)
+//                                                 core since Version, loaded as Alias on older versions with Extension enabled
+// Entries of extensions newer than the oldest supported Vulkan headers are guarded by the extension's macro
+
+#ifndef YK_VK_INSTANCE
+#define YK_VK_INSTANCE(name, version)
+#endif
+#ifndef YK_VK_INSTANCE_EXTENSION
+#define YK_VK_INSTANCE_EXTENSION(name, extension)
+#endif
+#ifndef YK_VK_INSTANCE_DEVICE_EXTENSION
+#define YK_VK_INSTANCE_DEVICE_EXTENSION(name, extension)
+#endif
+#ifndef YK_VK_DEVICE
+#define YK_VK_DEVICE(name, version)
+#endif
+#ifndef YK_VK_DEVICE_EXTENSION
+#define YK_VK_DEVICE_EXTENSION(name, extension)
+#endif
+#ifndef YK_VK_DEVICE_PROMOTED
+#define YK_VK_DEVICE_PROMOTED(name, version, alias, extension)
+#endif
+
+// clang-format off
+
+// =====================
+// Instance
+// =====================
+YK_VK_INSTANCE(DestroyInstance, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(EnumeratePhysicalDevices, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(EnumerateDeviceExtensionProperties, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(GetPhysicalDeviceProperties, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(GetPhysicalDeviceFeatures, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(GetPhysicalDeviceQueueFamilyProperties, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(GetPhysicalDeviceMemoryProperties, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(GetPhysicalDeviceFormatProperties, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(CreateDevice, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(GetDeviceProcAddr, VK_API_VERSION_1_0)
+YK_VK_INSTANCE(GetPhysicalDeviceProperties2, VK_API_VERSION_1_1)
+YK_VK_INSTANCE(GetPhysicalDeviceFeatures2, VK_API_VERSION_1_1)
+YK_VK_INSTANCE(GetPhysicalDeviceMemoryProperties2, VK_API_VERSION_1_1)
+
+YK_VK_INSTANCE_EXTENSION(DestroySurfaceKHR, VK_KHR_SURFACE_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(GetPhysicalDeviceSurfaceSupportKHR, VK_KHR_SURFACE_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(GetPhysicalDeviceSurfaceCapabilitiesKHR, VK_KHR_SURFACE_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(GetPhysicalDeviceSurfaceFormatsKHR, VK_KHR_SURFACE_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(GetPhysicalDeviceSurfacePresentModesKHR, VK_KHR_SURFACE_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(CreateWaylandSurfaceKHR, VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(CreateHeadlessSurfaceEXT, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(CreateDebugUtilsMessengerEXT, VK_EXT_DEBUG_UTILS_EXTENSION_NAME)
+YK_VK_INSTANCE_EXTENSION(DestroyDebugUtilsMessengerEXT, VK_EXT_DEBUG_UTILS_EXTENSION_NAME)
+
+YK_VK_INSTANCE_DEVICE_EXTENSION(GetPhysicalDeviceCalibrateableTimeDomainsEXT, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+#if defined(VK_KHR_calibrated_timestamps)
+YK_VK_INSTANCE_DEVICE_EXTENSION(GetPhysicalDeviceCalibrateableTimeDomainsKHR, VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+#endif
+
+// =====================
+// Device
+// =====================
+YK_VK_DEVICE(DestroyDevice, VK_API_VERSION_1_0)
+YK_VK_DEVICE(GetDeviceQueue, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DeviceWaitIdle, VK_API_VERSION_1_0)
+YK_VK_DEVICE(QueueWaitIdle, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE(AllocateMemory, VK_API_VERSION_1_0)
+YK_VK_DEVICE(FreeMemory, VK_API_VERSION_1_0)
+YK_VK_DEVICE(MapMemory, VK_API_VERSION_1_0)
+YK_VK_DEVICE(UnmapMemory, VK_API_VERSION_1_0)
+YK_VK_DEVICE(FlushMappedMemoryRanges, VK_API_VERSION_1_0)
+YK_VK_DEVICE(InvalidateMappedMemoryRanges, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE(CreateBuffer, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyBuffer, VK_API_VERSION_1_0)
+YK_VK_DEVICE(GetBufferMemoryRequirements, VK_API_VERSION_1_0)
+YK_VK_DEVICE(BindBufferMemory, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CreateImage, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyImage, VK_API_VERSION_1_0)
+YK_VK_DEVICE(GetImageMemoryRequirements, VK_API_VERSION_1_0)
+YK_VK_DEVICE(BindImageMemory, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CreateImageView, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyImageView, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE(CreateFence, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyFence, VK_API_VERSION_1_0)
+YK_VK_DEVICE(WaitForFences, VK_API_VERSION_1_0)
+YK_VK_DEVICE(ResetFences, VK_API_VERSION_1_0)
+YK_VK_DEVICE(GetFenceStatus, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CreateSemaphore, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroySemaphore, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE(CreateQueryPool, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyQueryPool, VK_API_VERSION_1_0)
+YK_VK_DEVICE(GetQueryPoolResults, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE(CreatePipelineCache, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyPipelineCache, VK_API_VERSION_1_0)
+YK_VK_DEVICE(GetPipelineCacheData, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CreateGraphicsPipelines, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CreateComputePipelines, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyPipeline, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE(CreateCommandPool, VK_API_VERSION_1_0)
+YK_VK_DEVICE(DestroyCommandPool, VK_API_VERSION_1_0)
+YK_VK_DEVICE(ResetCommandPool, VK_API_VERSION_1_0)
+YK_VK_DEVICE(AllocateCommandBuffers, VK_API_VERSION_1_0)
+YK_VK_DEVICE(FreeCommandBuffers, VK_API_VERSION_1_0)
+YK_VK_DEVICE(BeginCommandBuffer, VK_API_VERSION_1_0)
+YK_VK_DEVICE(EndCommandBuffer, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE(CmdBindPipeline, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdBindDescriptorSets, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdBindVertexBuffers, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdBindIndexBuffer, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdPushConstants, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdSetViewport, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdSetScissor, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdDraw, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdDrawIndexed, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdDrawIndexedIndirect, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdDispatch, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdCopyBuffer, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdCopyBufferToImage, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdCopyImageToBuffer, VK_API_VERSION_1_0)
+YK_VK_DEVICE(CmdResetQueryPool, VK_API_VERSION_1_0)
+
+YK_VK_DEVICE_PROMOTED(QueueSubmit2, VK_API_VERSION_1_3, QueueSubmit2KHR, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)
+YK_VK_DEVICE_PROMOTED(CmdPipelineBarrier2, VK_API_VERSION_1_3, CmdPipelineBarrier2KHR, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)
+YK_VK_DEVICE_PROMOTED(CmdWriteTimestamp2, VK_API_VERSION_1_3, CmdWriteTimestamp2KHR, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)
+YK_VK_DEVICE_PROMOTED(CmdBeginRendering, VK_API_VERSION_1_3, CmdBeginRenderingKHR, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)
+YK_VK_DEVICE_PROMOTED(CmdEndRendering, VK_API_VERSION_1_3, CmdEndRenderingKHR, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)
+
+YK_VK_DEVICE_EXTENSION(CreateSwapchainKHR, VK_KHR_SWAPCHAIN_EXTENSION_NAME)
+YK_VK_DEVICE_EXTENSION(DestroySwapchainKHR, VK_KHR_SWAPCHAIN_EXTENSION_NAME)
+YK_VK_DEVICE_EXTENSION(GetSwapchainImagesKHR, VK_KHR_SWAPCHAIN_EXTENSION_NAME)
+YK_VK_DEVICE_EXTENSION(AcquireNextImageKHR, VK_KHR_SWAPCHAIN_EXTENSION_NAME)
+YK_VK_DEVICE_EXTENSION(QueuePresentKHR, VK_KHR_SWAPCHAIN_EXTENSION_NAME)
+YK_VK_DEVICE_EXTENSION(GetCalibratedTimestampsEXT, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+#if defined(VK_KHR_calibrated_timestamps)
+YK_VK_DEVICE_EXTENSION(GetCalibratedTimestampsKHR, VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)
+#endif
+YK_VK_DEVICE_EXTENSION(CmdBeginDebugUtilsLabelEXT, VK_EXT_DEBUG_UTILS_EXTENSION_NAME)
+YK_VK_DEVICE_EXTENSION(CmdEndDebugUtilsLabelEXT, VK_EXT_DEBUG_UTILS_EXTENSION_NAME)
+YK_VK_DEVICE_EXTENSION(SetDebugUtilsObjectNameEXT, VK_EXT_DEBUG_UTILS_EXTENSION_NAME)
+
+// clang-format on
+
+#undef YK_VK_INSTANCE
+#undef YK_VK_INSTANCE_EXTENSION
+#undef YK_VK_INSTANCE_DEVICE_EXTENSION
+#undef YK_VK_DEVICE
+#undef YK_VK_DEVICE_EXTENSION
+#undef YK_VK_DEVICE_PROMOTED
@@ -0,0 +1,231 @@
+#include "York/Graphics/Vulkan/gpu_profiler.hpp"
+#include "York/Graphics/Vulkan/helpers.hpp"
+#include "York/Core/error.hpp"
+#include <algorithm>
+#include <format>
+
+namespace york::vulkan {
+
+// =====================
+// Profiler Creation
+// =====================
+Result<std::unique_ptr<GPUProfiler>> GPUProfiler::Create(const GPUProfilerCreateInfo &createInfo) {
+  if (!createInfo.Dispatch)
+    return YK_RESULT_FAILURE(Error::Create("GPUProfiler requires a DeviceDispatch"));
+  if (!createInfo.Dispatch->CmdWriteTimestamp2)
+    return YK_RESULT_FAILURE(Error::Create(std::format("GPUProfiler requires Vulkan 1.3 or {}", VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)));
+
+  const auto &vk = *createInfo.Dispatch;
+  auto profiler = std::unique_ptr<GPUProfiler>(new GPUProfiler());
+  profiler->m_Dispatch = createInfo.Dispatch;
+
+  uint32_t count(0);
+  vk.Instance->GetPhysicalDeviceQueueFamilyProperties(createInfo.PhysicalDevice, &count, nullptr);
+  std::vector<VkQueueFamilyProperties> queues(count);
+  vk.Instance->GetPhysicalDeviceQueueFamilyProperties(createInfo.PhysicalDevice, &count, queues.data());
+
+  if (createInfo.QueueFamilyIndex >= queues.size() || queues[createInfo.QueueFamilyIndex].timestampValidBits == 0)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Queue family {} does not support timestamps", createInfo.QueueFamilyIndex)));
+
+  const uint32_t validBits = queues[createInfo.QueueFamilyIndex].timestampValidBits;
+  profiler->m_TimestampMask = validBits >= 64 ? ~0ULL : (1ULL << validBits) - 1;
+  profiler->m_TimestampValidBits = std::min(validBits, 64U);
+
+  VkPhysicalDeviceProperties props;
+  vk.Instance->GetPhysicalDeviceProperties(createInfo.PhysicalDevice, &props);
+  profiler->m_TimestampPeriod = static_cast<double>(props.limits.timestampPeriod);
+
+  profiler->m_QueriesPerSlot = 1 + createInfo.MaxZonesPerFrame * 2;
+  profiler->m_Slots.resize(std::max(createInfo.FramesInFlight, 1U));
+  profiler->m_Results.resize(profiler->m_QueriesPerSlot);
+
+  const VkQueryPoolCreateInfo queryCI{
+      .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = {},
+      .queryType = VK_QUERY_TYPE_TIMESTAMP,
+      .queryCount = profiler->m_QueriesPerSlot * static_cast<uint32_t>(profiler->m_Slots.size()),
+      .pipelineStatistics = {},
+  };
+
+  if (auto code = vk.CreateQueryPool(vk.Device, &queryCI, nullptr, &profiler->m_QueryPool); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateQueryPool failed: {}", ToString(code))));
+
+  if (createInfo.EnableDebugLabels) {
+    profiler->m_CmdBeginLabel = vk.CmdBeginDebugUtilsLabelEXT;
+    profiler->m_CmdEndLabel = vk.CmdEndDebugUtilsLabelEXT;
+  }
+
+  if (createInfo.EnableCalibration) {
+    // Calibration is only useful when the device clock can be sampled against CLOCK_MONOTONIC,
+    // which is the clock behind std::chrono::steady_clock used by york::Profiler
+    auto getTimeDomains = vk.Instance->GetPhysicalDeviceCalibrateableTimeDomainsEXT;
+    auto getTimestamps = vk.GetCalibratedTimestampsEXT;
+#if defined(VK_KHR_calibrated_timestamps)
+    // The KHR promotion keeps the EXT signatures, a device enables either one
+    if (!getTimestamps) {
+      getTimeDomains = vk.Instance->GetPhysicalDeviceCalibrateableTimeDomainsKHR;
+      getTimestamps = vk.GetCalibratedTimestampsKHR;
+    }
+#endif
+
+    if (getTimeDomains && getTimestamps) {
+      count = 0;
+      getTimeDomains(createInfo.PhysicalDevice, &count, nullptr);
+      std::vector<VkTimeDomainEXT> domains(count);
+      getTimeDomains(createInfo.PhysicalDevice, &count, domains.data());
+
+      const bool hasDevice = std::ranges::find(domains, VK_TIME_DOMAIN_DEVICE_EXT) != domains.end();
+      const bool hasMonotonic = std::ranges::find(domains, VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT) != domains.end();
+      if (hasDevice && hasMonotonic) {
+        profiler->m_GetCalibratedTimestamps = getTimestamps;
+        profiler->m_Calibrated = true;
+      }
+    }
+  }
+
+  return YK_RESULT_SUCCESS(profiler);
+}
+
+// =====================
+// Recording
+// =====================
+void GPUProfiler::BeginFrame(VkCommandBuffer cmd, uint32_t slot) {
+  m_CurrentSlot = slot % static_cast<uint32_t>(m_Slots.size());
+  auto &frame = m_Slots[m_CurrentSlot];
+
+  if (frame.Recorded)
+    Collect(m_CurrentSlot);
+
+  frame.FrameIndex = Profiler::GetFrameIndex();
+  frame.QueryCount = 1;
+  frame.Zones.clear();
+  m_OpenZones.clear();
+
+  frame.Calibrated = m_Calibrated && Calibrate(frame.CalibrationTicks, frame.CalibrationNanoseconds);
+  if (!frame.Calibrated)
+    frame.CalibrationNanoseconds = Profiler::Now();
+
+  const uint32_t first = m_CurrentSlot * m_QueriesPerSlot;
+  m_Dispatch->CmdResetQueryPool(cmd, m_QueryPool, first, m_QueriesPerSlot);
+  m_Dispatch->CmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, m_QueryPool, first);
+  frame.Recorded = true;
+}
+
+void GPUProfiler::BeginZone(VkCommandBuffer cmd, const char *name, VkPipelineStageFlags2 stage) {
+  if (m_CmdBeginLabel) {
+    const VkDebugUtilsLabelEXT label{
+        .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
+        .pNext = nullptr,
+        .pLabelName = name,
+        .color = {0.0f, 0.0f, 0.0f, 0.0f},
+    };
+    m_CmdBeginLabel(cmd, &label);
+  }
+
+  auto &frame = m_Slots[m_CurrentSlot];
+  // Keep the stack balanced even when the zone does not fit, EndZone pops UINT32_MAX
+  if (frame.QueryCount + 2 > m_QueriesPerSlot) {
+    m_OpenZones.push_back(UINT32_MAX);
+    return;
+  }
+
+  const uint32_t query = frame.QueryCount;
+  frame.QueryCount += 2;
+  frame.Zones.push_back({
+      .Name = name,
+      .BeginQuery = query,
+      .EndQuery = query + 1,
+      .Depth = static_cast<uint32_t>(m_OpenZones.size()),
+  });
+  m_OpenZones.push_back(static_cast<uint32_t>(frame.Zones.size() - 1));
+
+  m_Dispatch->CmdWriteTimestamp2(cmd, stage, m_QueryPool, m_CurrentSlot * m_QueriesPerSlot + query);
+}
+
+void GPUProfiler::EndZone(VkCommandBuffer cmd, VkPipelineStageFlags2 stage) {
+  if (m_CmdEndLabel)
+    m_CmdEndLabel(cmd);
+
+  if (m_OpenZones.empty())
+    return;
+
+  const uint32_t zone = m_OpenZones.back();
+  m_OpenZones.pop_back();
+  if (zone == UINT32_MAX)
+    return;
+
+  const auto &frame = m_Slots[m_CurrentSlot];
+  m_Dispatch->CmdWriteTimestamp2(cmd, stage, m_QueryPool, m_CurrentSlot * m_QueriesPerSlot + frame.Zones[zone].EndQuery);
+}
+
+// =====================
+// Readback
+// =====================
+// A preempted sample reports a large deviation, it is retried a few times before the frame goes uncalibrated
+bool GPUProfiler::Calibrate(uint64_t &gpuTicks, uint64_t &cpuNanoseconds) const {
+  const VkCalibratedTimestampInfoEXT infos[2]{
+      {.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, .pNext = nullptr, .timeDomain = VK_TIME_DOMAIN_DEVICE_EXT},
+      {.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, .pNext = nullptr, .timeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT},
+  };
+
+  for (uint32_t attempt(0); attempt < MAX_CALIBRATION_ATTEMPTS; ++attempt) {
+    uint64_t timestamps[2]{};
+    uint64_t maxDeviation = 0;
+    if (m_GetCalibratedTimestamps(m_Dispatch->Device, 2, infos, timestamps, &maxDeviation) != VK_SUCCESS)
+      return false;
+    if (maxDeviation > MAX_CALIBRATION_DEVIATION_NS)
+      continue;
+
+    gpuTicks = timestamps[0] & m_TimestampMask;
+    cpuNanoseconds = timestamps[1];
+    return true;
+  }
+  return false;
+}
+
+void GPUProfiler::Collect(uint32_t slot) {
+  auto &frame = m_Slots[slot];
+  frame.Recorded = false;
+
+  // The caller waited the fence of this slot, VK_NOT_READY means the frame was never submitted
+  const uint32_t first = slot * m_QueriesPerSlot;
+  if (auto code = m_Dispatch->GetQueryPoolResults(m_Dispatch->Device, m_QueryPool, first, frame.QueryCount,
+                                                  frame.QueryCount * sizeof(uint64_t), m_Results.data(), sizeof(uint64_t),
+                                                  VK_QUERY_RESULT_64_BIT);
+      code != VK_SUCCESS)
+    return;
+
+  const uint64_t anchorTicks = frame.Calibrated ? frame.CalibrationTicks : (m_Results[0] & m_TimestampMask);
+  // The difference is taken modulo the counter width so a wrap between the anchor and a zone stays small,
+  // then sign-extended from the valid bits (a zone may start before the calibration sample)
+  const uint64_t signBit = 1ULL << (m_TimestampValidBits - 1);
+  auto toCPU = [&](uint64_t ticks) -> uint64_t {
+    uint64_t wrapped = (ticks - anchorTicks) & m_TimestampMask;
+    if (wrapped & signBit)
+      wrapped |= ~m_TimestampMask;
+    const auto delta = static_cast<int64_t>(wrapped);
+    return frame.CalibrationNanoseconds + static_cast<uint64_t>(static_cast<int64_t>(static_cast<double>(delta) * m_TimestampPeriod));
+  };
+
+  m_Converted.clear();
+  for (const auto &zone : frame.Zones) {
+    m_Converted.push_back({
+        .Name = zone.Name,
+        .Begin = toCPU(m_Results[zone.BeginQuery]),
+        .End = toCPU(m_Results[zone.EndQuery]),
+        .Depth = zone.Depth,
+    });
+  }
+
+  Profiler::SubmitGPUZones(frame.FrameIndex, m_Converted);
+}
+
+// =====================
+// Destructor
+// =====================
+GPUProfiler::~GPUProfiler() {
+  if (m_QueryPool)
+    m_Dispatch->DestroyQueryPool(m_Dispatch->Device, m_QueryPool, nullptr);
+}
+} // namespace york::vulkan
@@ -0,0 +1,119 @@
+#pragma once
+
+/*
+ * GPU Timestamp Zones feeding york::Profiler
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <memory>
+#include <vector>
+#include "York/Core/profiler.hpp"
+#include "York/Core/result.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
+
+namespace york::vulkan {
+
+// FramesInFlight must match the number of frames the renderer keeps in flight
+// EnableDebugLabels requires VK_EXT_debug_utils on the Instance
+// EnableCalibration requires VK_EXT_calibrated_timestamps (or VK_KHR_calibrated_timestamps) on the Device
+// Timestamps are written with vkCmdWriteTimestamp2, the Device needs Vulkan 1.3 or VK_KHR_synchronization2
+struct GPUProfilerCreateInfo {
+  VkPhysicalDevice PhysicalDevice = VK_NULL_HANDLE;
+  const DeviceDispatch *Dispatch = nullptr;
+  uint32_t QueueFamilyIndex = 0;
+  uint32_t FramesInFlight = 2;
+  uint32_t MaxZonesPerFrame = 64;
+  bool EnableDebugLabels = true;
+  bool EnableCalibration = true;
+};
+
+// Usage:
+// After waiting the fence of a frame slot: profiler->BeginFrame(cmd, slot)
+// Around passes: { GPUProfileScope zone(*profiler, cmd, "Pass"); ... }
+// Results of a slot are read back the next time the slot begins, and handed to Profiler::SubmitGPUZones
+// GPU ticks are mapped to the CPU steady clock with calibrated timestamps when available,
+// otherwise the first timestamp of the frame is aligned with the CPU time of BeginFrame
+// A frame whose calibration fails or stays above MAX_CALIBRATION_DEVIATION_NS falls back to that alignment
+class GPUProfiler {
+public:
+  static constexpr uint64_t MAX_CALIBRATION_DEVIATION_NS = 50'000;
+  static constexpr uint32_t MAX_CALIBRATION_ATTEMPTS = 3;
+
+public:
+  static Result<std::unique_ptr<GPUProfiler>> Create(const GPUProfilerCreateInfo &createInfo);
+
+public:
+  void BeginFrame(VkCommandBuffer cmd, uint32_t slot);
+
+  // Zones are skipped once MaxZonesPerFrame is reached
+  void BeginZone(VkCommandBuffer cmd, const char *name, VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT);
+  void EndZone(VkCommandBuffer cmd, VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT);
+
+  bool IsCalibrated() const noexcept { return m_Calibrated; }
+
+private:
+  GPUProfiler() = default;
+
+  void Collect(uint32_t slot);
+  bool Calibrate(uint64_t &gpuTicks, uint64_t &cpuNanoseconds) const;
+
+public:
+  ~GPUProfiler();
+  GPUProfiler(const GPUProfiler &) = delete;
+  GPUProfiler &operator=(const GPUProfiler &) = delete;
+
+private:
+  struct PendingZone {
+    const char *Name = nullptr;
+    uint32_t BeginQuery = 0;
+    uint32_t EndQuery = 0;
+    uint32_t Depth = 0;
+  };
+
+  // Query 0 of each slot is the frame anchor, zones use the queries after it
+  struct FrameSlot {
+    uint64_t FrameIndex = 0;
+    uint64_t CalibrationTicks = 0;
+    uint64_t CalibrationNanoseconds = 0;
+    uint32_t QueryCount = 0;
+    bool Calibrated = false;
+    bool Recorded = false;
+    std::vector<PendingZone> Zones;
+  };
+
+private:
+  const DeviceDispatch *m_Dispatch = nullptr;
+  VkQueryPool m_QueryPool = VK_NULL_HANDLE;
+  uint32_t m_QueriesPerSlot = 0;
+  uint64_t m_TimestampMask = ~0ULL;
+  uint32_t m_TimestampValidBits = 64;
+  double m_TimestampPeriod = 1.0;
+  bool m_Calibrated = false;
+
+  uint32_t m_CurrentSlot = 0;
+  std::vector<FrameSlot> m_Slots;
+  std::vector<uint32_t> m_OpenZones;
+  std::vector<uint64_t> m_Results;
+  std::vector<GPUProfileZone> m_Converted;
+
+  PFN_vkCmdBeginDebugUtilsLabelEXT m_CmdBeginLabel = nullptr;
+  PFN_vkCmdEndDebugUtilsLabelEXT m_CmdEndLabel = nullptr;
+  PFN_vkGetCalibratedTimestampsEXT m_GetCalibratedTimestamps = nullptr;
+};
+
+// RAII GPU Zone, also records a CPU zone of the same name
+class GPUProfileScope {
+public:
+  GPUProfileScope(GPUProfiler &profiler, VkCommandBuffer cmd, const char *name) : m_Profiler(profiler), m_Cmd(cmd), m_CPUScope(name) {
+    m_Profiler.BeginZone(m_Cmd, name);
+  }
+  ~GPUProfileScope() { m_Profiler.EndZone(m_Cmd); }
+  GPUProfileScope(const GPUProfileScope &) = delete;
+  GPUProfileScope &operator=(const GPUProfileScope &) = delete;
+
+private:
+  GPUProfiler &m_Profiler;
+  VkCommandBuffer m_Cmd;
+  ProfileScope m_CPUScope;
+};
+} // namespace york::vulkan
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <vulkan/vulkan_core.h>
+#include <optional>
 #include <string>
 #include "York/Helpers/version.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
 
 namespace york::vulkan {
 enum class APIVersion : uint32_t {
@@ -121,4 +123,18 @@ static std::string ToString(VkResult result) {
   return "UNKNOWN_RESULT";
 }
 
+// Index of the first memory type allowed by typeBits that has every flag in required
+static std::optional<uint32_t> FindMemoryType(const InstanceDispatch &dispatch, VkPhysicalDevice device, uint32_t typeBits,
+                                              VkMemoryPropertyFlags required) {
+  VkPhysicalDeviceMemoryProperties props;
+  dispatch.GetPhysicalDeviceMemoryProperties(device, &props);
+
+  for (uint32_t i(0); i < props.memoryTypeCount; ++i) {
+    if ((typeBits & (1U << i)) && (props.memoryTypes[i].propertyFlags & required) == required)
+      return i;
+  }
+
+  return std::nullopt;
+}
+
 } // namespace york::vulkan
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include "York/Graphics/Vulkan/instance.hpp"
 #include "York/Core/error.hpp"
-#include "York/Core/gui.hpp"
 #include "York/Core/result.hpp"
 #include "York/Helpers/strings.hpp"
 #include <cstddef>
 #include <cstdint>
+#include <format>
 #include <vector>
 #include <vulkan/vulkan_core.h>
 
@@ -14,7 +14,7 @@ namespace york::vulkan {
 // Instance Creation
 // =====================
 template <typename Platform>
-Result<std::shared_ptr<Instance>, Instance> Instance::Create(const InstanceCreateInfo &createInfo) {
+Result<std::shared_ptr<Instance>> Instance::Create(const InstanceCreateInfo &createInfo) {
   auto instance = std::shared_ptr<Instance>(new Instance());
 
   // clang-format off
@@ -23,13 +23,16 @@ Result<std::shared_ptr<Instance>, Instance> Instance::Create(const InstanceCreat
   
   std::vector<const char *> extensions{createInfo.Extensions};
   if (createInfo.EnableDebugMessenger) extensions.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-
-  extensions.emplace_back(VK_KHR_SURFACE_EXTENSION_NAME);
-  extensions.emplace_back(PlatformTraits<Platform>::VULKAN_EXTENSION_NAME);
   // clang-format on
 
-  if (auto status = instance->ValidateCreateInfo(createInfo); !status.has_value())
-    return failure<std::unique_ptr<Instance>, Instance>(status, ErrorCode::VKValidation);
+  // Headless rendering can run on drivers without VK_EXT_headless_surface, it then skips the surface entirely
+  const std::vector<const char *> surfaceExtensions{VK_KHR_SURFACE_EXTENSION_NAME, PlatformTraits<Platform>::VULKAN_EXTENSION_NAME};
+  const bool hasSurface = !PlatformTraits<Platform>::SURFACE_OPTIONAL || Instance::GetInvalidExtensions(surfaceExtensions).empty();
+  if (hasSurface)
+    extensions.insert(extensions.end(), surfaceExtensions.begin(), surfaceExtensions.end());
+
+  if (auto status = Instance::ValidateCreateInfo(createInfo); !status)
+    return YK_RESULT_FAILURE(status.error());
 
   const VkApplicationInfo appCI{
       .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
@@ -53,19 +56,24 @@ Result<std::shared_ptr<Instance>, Instance> Instance::Create(const InstanceCreat
   };
 
   if (auto code = vkCreateInstance(&instanceCI, nullptr, &instance->m_VkInstance); code != VK_SUCCESS)
-    return failure<std::unique_ptr<Instance>, Instance>(ToString(code), ErrorCode::VKCreation);
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateInstance failed: {}", ToString(code))));
 
+  instance->m_Dispatch.Load(instance->m_VkInstance, appCI.apiVersion, extensions);
   instance->m_APIVersion = createInfo.ApiVersion;
-  return instance;
+  instance->m_SurfaceSupport = hasSurface;
+  return YK_RESULT_SUCCESS(instance);
 }
 
-template Result<std::shared_ptr<Instance>, Instance>
+template Result<std::shared_ptr<Instance>>
 Instance::Create<Wayland>(const InstanceCreateInfo &createInfo);
 
+template Result<std::shared_ptr<Instance>>
+Instance::Create<Headless>(const InstanceCreateInfo &createInfo);
+
 // =====================
 // Create Info Validation
 // =====================
-Status Instance::ValidateCreateInfo(const InstanceCreateInfo &createInfo) {
+Result<> Instance::ValidateCreateInfo(const InstanceCreateInfo &createInfo) {
   auto layers = Instance::GetInvalidLayers(createInfo.Layers);
   auto extensions = Instance::GetInvalidExtensions(createInfo.Extensions);
 
@@ -74,12 +82,12 @@ Status Instance::ValidateCreateInfo(const InstanceCreateInfo &createInfo) {
     error += std::format("Requested Instance Layers are not available: {}\n", york::strings::join(layers));
 
   if (extensions.size() > 0)
-    error += std::format("Requested Instance Extensions are not available: {}\n", york::strings::join(layers));
+    error += std::format("Requested Instance Extensions are not available: {}\n", york::strings::join(extensions));
 
   if (!error.empty())
-    return failure("Invalid Instance Create Info:\n{}", error);
+    return YK_RESULT_FAILURE(Error::Create(std::format("Invalid Instance Create Info:\n{}", error)));
 
-  return STATUS_SUCCESS;
+  return YK_RESULT_SUCCESS({});
 }
 
 std::vector<std::string> Instance::GetInvalidLayers(const std::vector<const char *> &requested) {
@@ -130,7 +138,7 @@ std::vector<std::string> Instance::GetInvalidExtensions(const std::vector<const
 // Runtime Operations
 // =====================
 
-Result<void, VkDebugUtilsMessengerEXT> Instance::EnableDebugMessenger(const DebugMessengerCreateInfo &ci) {
+Result<> Instance::EnableDebugMessenger(const DebugMessengerCreateInfo &ci) {
   const VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo{
       .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT,
       .pNext = nullptr,
@@ -141,25 +149,25 @@ Result<void, VkDebugUtilsMessengerEXT> Instance::EnableDebugMessenger(const Debu
       .pUserData = nullptr,
   };
 
-  auto vkCreateDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
-      vkGetInstanceProcAddr(m_VkInstance, "vkCreateDebugUtilsMessengerEXT"));
+  if (!m_Dispatch.CreateDebugUtilsMessengerEXT)
+    return YK_RESULT_FAILURE(Error::Create(std::format("{} is not enabled on the Instance", VK_EXT_DEBUG_UTILS_EXTENSION_NAME)));
 
-  if (auto code = vkCreateDebugUtilsMessengerEXT(m_VkInstance, &debugCreateInfo, nullptr, &m_DebugMessenger); code != VK_SUCCESS)
-    return failure<void, VkDebugUtilsMessengerEXT>(ToString(code), ErrorCode::VKCreation);
+  if (auto code = m_Dispatch.CreateDebugUtilsMessengerEXT(m_VkInstance, &debugCreateInfo, nullptr, &m_DebugMessenger); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateDebugUtilsMessengerEXT failed: {}", ToString(code))));
 
-  return {};
+  return YK_RESULT_SUCCESS({});
 }
 
 std::vector<PhysicalDevice> Instance::EnumeratePhysicalDevices() const {
   uint32_t count(0);
-  vkEnumeratePhysicalDevices(m_VkInstance, &count, nullptr);
+  m_Dispatch.EnumeratePhysicalDevices(m_VkInstance, &count, nullptr);
   std::vector<VkPhysicalDevice> devices(count);
-  vkEnumeratePhysicalDevices(m_VkInstance, &count, devices.data());
+  m_Dispatch.EnumeratePhysicalDevices(m_VkInstance, &count, devices.data());
 
   std::vector<PhysicalDevice> result;
   for (const auto &device : devices) {
     VkPhysicalDeviceProperties props;
-    vkGetPhysicalDeviceProperties(device, &props);
+    m_Dispatch.GetPhysicalDeviceProperties(device, &props);
 
     PhysicalDevice parsed{
         .Name = props.deviceName,
@@ -169,9 +177,9 @@ std::vector<PhysicalDevice> Instance::EnumeratePhysicalDevices() const {
     };
 
     count = 0;
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &count, nullptr);
+    m_Dispatch.GetPhysicalDeviceQueueFamilyProperties(device, &count, nullptr);
     std::vector<VkQueueFamilyProperties> queues(count);
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &count, queues.data());
+    m_Dispatch.GetPhysicalDeviceQueueFamilyProperties(device, &count, queues.data());
 
     for (uint32_t i(0); i < queues.size(); ++i) {
       QueueRole roles = QueueRole::None;
@@ -193,12 +201,9 @@ std::vector<PhysicalDevice> Instance::EnumeratePhysicalDevices() const {
 // Destructor
 // =====================
 Instance::~Instance() {
-  if (m_DebugMessenger) {
-    auto vkDestroyDebugUtilsMessengerEXT = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
-        vkGetInstanceProcAddr(m_VkInstance, "vkDestroyDebugUtilsMessengerEXT"));
-    vkDestroyDebugUtilsMessengerEXT(m_VkInstance, m_DebugMessenger, nullptr);
-  }
+  if (m_DebugMessenger)
+    m_Dispatch.DestroyDebugUtilsMessengerEXT(m_VkInstance, m_DebugMessenger, nullptr);
   if (m_VkInstance)
-    vkDestroyInstance(m_VkInstance, nullptr);
+    m_Dispatch.DestroyInstance(m_VkInstance, nullptr);
 }
 } // namespace york::vulkan
\ No newline at end of file
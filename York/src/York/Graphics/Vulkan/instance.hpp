@@ -7,9 +7,11 @@
 #include "York/Core/result.hpp"
 #include "York/Helpers/version.hpp"
 #include "York/Graphics/Vulkan/debug.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
 #include "York/Graphics/Vulkan/helpers.hpp"
 #include "York/Graphics/Vulkan/physical_device.hpp"
 
+#include "York/Platform/Headless/headless.hpp"
 #include "York/Platform/Wayland/wayland.hpp"
 
 namespace york::vulkan {
@@ -38,18 +40,19 @@ struct DebugMessengerCreateInfo {
 
 // Wrapper around VkInstance
 // Additionally it handles Enumerating Physical Devices, and Enabling DebugMessenger Utilities
+// Instance-level functions are loaded once into GetDispatch(), DeviceDispatch::Load builds on it
 // Copy operators is removed to ensure having only one pointer to internal pointers at a time
 class Instance {
 public:
   // Platform template to handle automatically adding VK_*_SURFACE_EXTENSION_NAME
   // Shared Pointer is added to lightly manage lifetime of Instance
   template <typename Platform>
-  static Result<std::shared_ptr<Instance>, Instance> Create(const InstanceCreateInfo &createInfo);
+  static Result<std::shared_ptr<Instance>> Create(const InstanceCreateInfo &createInfo);
 
 public:
   // Ensure the existance of all required Extensions and Layers
   // Create Error Message for Instance::GetInvalidLayers and Instance::GetInvalidExtensions
-  static Status ValidateCreateInfo(const InstanceCreateInfo &createInfo);
+  static Result<> ValidateCreateInfo(const InstanceCreateInfo &createInfo);
 
   // Helper to Instance::ValidateCreateInfo
   static std::vector<std::string> GetInvalidLayers(const std::vector<const char *> &requested);
@@ -58,7 +61,7 @@ public:
   static std::vector<std::string> GetInvalidExtensions(const std::vector<const char *> &requested);
 
 public:
-  Result<void, VkDebugUtilsMessengerEXT> EnableDebugMessenger(const DebugMessengerCreateInfo &debugCreateInfo);
+  Result<> EnableDebugMessenger(const DebugMessengerCreateInfo &debugCreateInfo);
 
   // Enumerate and Parse Found Physical Devices
   // std::vector<>::size = 0 in case of an Error
@@ -75,15 +78,23 @@ public:
 public:
   APIVersion GetVersion() const noexcept { return m_APIVersion; }
   VkInstance Get() const noexcept { return m_VkInstance; }
+  const InstanceDispatch &GetDispatch() const noexcept { return m_Dispatch; }
+  // False when a SURFACE_OPTIONAL platform was created without its surface extensions
+  bool HasSurfaceSupport() const noexcept { return m_SurfaceSupport; }
 
 private:
   APIVersion m_APIVersion;
+  bool m_SurfaceSupport = false;
   VkInstance m_VkInstance = VK_NULL_HANDLE;
   VkDebugUtilsMessengerEXT m_DebugMessenger = VK_NULL_HANDLE;
+  InstanceDispatch m_Dispatch;
 };
 
 // Specialization fpr Instance::Create template
-extern template Result<std::shared_ptr<Instance>, Instance>
+extern template Result<std::shared_ptr<Instance>>
 Instance::Create<Wayland>(const InstanceCreateInfo &);
 
+extern template Result<std::shared_ptr<Instance>>
+Instance::Create<Headless>(const InstanceCreateInfo &);
+
 } // namespace york::vulkan
\ No newline at end of file
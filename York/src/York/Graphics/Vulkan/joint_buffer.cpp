@@ -0,0 +1,114 @@
+#include "York/Graphics/Vulkan/joint_buffer.hpp"
+#include "York/Graphics/Vulkan/helpers.hpp"
+#include "York/Core/error.hpp"
+#include <algorithm>
+#include <format>
+
+namespace york::vulkan {
+
+static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+// =====================
+// Buffer Creation
+// =====================
+Result<std::unique_ptr<JointBuffer>> JointBuffer::Create(const JointBufferCreateInfo &createInfo) {
+  if (!createInfo.Dispatch)
+    return YK_RESULT_FAILURE(Error::Create("JointBuffer requires a DeviceDispatch"));
+
+  const auto &vk = *createInfo.Dispatch;
+  auto buffer = std::unique_ptr<JointBuffer>(new JointBuffer());
+  buffer->m_Dispatch = createInfo.Dispatch;
+  buffer->m_SlotCount = std::max(createInfo.FramesInFlight, 1U);
+
+  VkPhysicalDeviceProperties props;
+  vk.Instance->GetPhysicalDeviceProperties(createInfo.PhysicalDevice, &props);
+  buffer->m_NonCoherentAtomSize = std::max<VkDeviceSize>(props.limits.nonCoherentAtomSize, 1);
+
+  // Slots are bound at their offset and flushed independently
+  const VkDeviceSize alignment = std::max(props.limits.minStorageBufferOffsetAlignment, buffer->m_NonCoherentAtomSize);
+  buffer->m_SlotSize = static_cast<VkDeviceSize>(std::max(createInfo.MaxJoints, 1U)) * sizeof(Mat4);
+  buffer->m_SlotStride = AlignUp(buffer->m_SlotSize, alignment);
+
+  const VkBufferCreateInfo bufferCI{
+      .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = {},
+      .size = buffer->m_SlotStride * buffer->m_SlotCount,
+      .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+      .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+      .queueFamilyIndexCount = 0,
+      .pQueueFamilyIndices = nullptr,
+  };
+
+  if (auto code = vk.CreateBuffer(vk.Device, &bufferCI, nullptr, &buffer->m_Buffer); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateBuffer failed: {}", ToString(code))));
+
+  VkMemoryRequirements requirements;
+  vk.GetBufferMemoryRequirements(vk.Device, buffer->m_Buffer, &requirements);
+
+  // Device local + host visible avoids a staging copy, plain host visible is read over PCIe by the shader
+  auto memoryType = FindMemoryType(*vk.Instance, createInfo.PhysicalDevice, requirements.memoryTypeBits,
+                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+  if (!memoryType)
+    memoryType = FindMemoryType(*vk.Instance, createInfo.PhysicalDevice, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+  if (!memoryType)
+    return YK_RESULT_FAILURE(Error::Create("No host visible memory type for joint buffer"));
+
+  VkPhysicalDeviceMemoryProperties memoryProps;
+  vk.Instance->GetPhysicalDeviceMemoryProperties(createInfo.PhysicalDevice, &memoryProps);
+  buffer->m_Coherent = memoryProps.memoryTypes[*memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+  VkMemoryAllocateInfo allocateInfo{
+      .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+      .pNext = nullptr,
+      .allocationSize = requirements.size,
+      .memoryTypeIndex = *memoryType,
+  };
+  // Read by every skinned draw of every frame
+  VkMemoryPriorityAllocateInfoEXT priorityInfo{};
+  if (createInfo.Budget)
+    createInfo.Budget->ApplyPriority(allocateInfo, priorityInfo, 1.0f);
+
+  if (auto code = vk.AllocateMemory(vk.Device, &allocateInfo, nullptr, &buffer->m_Memory); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkAllocateMemory failed: {}", ToString(code))));
+
+  if (auto code = vk.BindBufferMemory(vk.Device, buffer->m_Buffer, buffer->m_Memory, 0); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkBindBufferMemory failed: {}", ToString(code))));
+
+  void *mapped = nullptr;
+  if (auto code = vk.MapMemory(vk.Device, buffer->m_Memory, 0, VK_WHOLE_SIZE, 0, &mapped); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkMapMemory failed: {}", ToString(code))));
+  buffer->m_Mapped = static_cast<std::byte *>(mapped);
+
+  return YK_RESULT_SUCCESS(buffer);
+}
+
+// =====================
+// Runtime Operations
+// =====================
+void JointBuffer::Flush(uint32_t slot) const {
+  if (m_Coherent)
+    return;
+
+  const VkMappedMemoryRange range{
+      .sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+      .pNext = nullptr,
+      .memory = m_Memory,
+      .offset = GetOffset(slot),
+      .size = AlignUp(m_SlotSize, m_NonCoherentAtomSize),
+  };
+  m_Dispatch->FlushMappedMemoryRanges(m_Dispatch->Device, 1, &range);
+}
+
+// =====================
+// Destructor
+// =====================
+JointBuffer::~JointBuffer() {
+  if (m_Mapped)
+    m_Dispatch->UnmapMemory(m_Dispatch->Device, m_Memory);
+  if (m_Buffer)
+    m_Dispatch->DestroyBuffer(m_Dispatch->Device, m_Buffer, nullptr);
+  if (m_Memory)
+    m_Dispatch->FreeMemory(m_Dispatch->Device, m_Memory, nullptr);
+}
+} // namespace york::vulkan
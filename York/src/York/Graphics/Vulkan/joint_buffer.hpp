@@ -0,0 +1,66 @@
+#pragma once
+
+/*
+ * Persistently Mapped Joint Matrix Buffer
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <cstddef>
+#include <memory>
+#include "York/Core/result.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
+#include "York/Graphics/Vulkan/memory_budget.hpp"
+#include "York/Math/math.hpp"
+
+namespace york::vulkan {
+
+// MaxJoints is the total joint count of every skin drawn in a frame (TransformHierarchy::GetTotalJointCount)
+// Budget is optional, with it the buffer gets the highest memory priority
+struct JointBufferCreateInfo {
+  VkPhysicalDevice PhysicalDevice = VK_NULL_HANDLE;
+  const DeviceDispatch *Dispatch = nullptr;
+  const MemoryBudget *Budget = nullptr;
+  uint32_t MaxJoints = 0;
+  uint32_t FramesInFlight = 2;
+};
+
+// One storage buffer holding a slot of MaxJoints matrices per frame in flight
+// Usage:
+// After waiting the fence of a frame slot: hierarchy->WriteJointMatrices(buffer->Map(slot)); buffer->Flush(slot)
+// Bind GetBuffer() at GetOffset(slot) with GetSlotSize() as a storage buffer
+// Prefers device local + host visible memory (resizable BAR) so shaders read it without a copy
+class JointBuffer {
+public:
+  static Result<std::unique_ptr<JointBuffer>> Create(const JointBufferCreateInfo &createInfo);
+
+public:
+  Mat4 *Map(uint32_t slot) const noexcept { return reinterpret_cast<Mat4 *>(m_Mapped + GetOffset(slot)); }
+
+  // No-op on coherent memory
+  void Flush(uint32_t slot) const;
+
+  VkBuffer GetBuffer() const noexcept { return m_Buffer; }
+  VkDeviceSize GetOffset(uint32_t slot) const noexcept { return m_SlotStride * (slot % m_SlotCount); }
+  VkDeviceSize GetSlotSize() const noexcept { return m_SlotSize; }
+
+private:
+  JointBuffer() = default;
+
+public:
+  ~JointBuffer();
+  JointBuffer(const JointBuffer &) = delete;
+  JointBuffer &operator=(const JointBuffer &) = delete;
+
+private:
+  const DeviceDispatch *m_Dispatch = nullptr;
+  VkBuffer m_Buffer = VK_NULL_HANDLE;
+  VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+  std::byte *m_Mapped = nullptr;
+  bool m_Coherent = false;
+  VkDeviceSize m_NonCoherentAtomSize = 1;
+
+  uint32_t m_SlotCount = 1;
+  VkDeviceSize m_SlotSize = 0;
+  VkDeviceSize m_SlotStride = 0;
+};
+} // namespace york::vulkan
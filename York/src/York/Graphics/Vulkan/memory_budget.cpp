@@ -0,0 +1,229 @@
+#include "York/Graphics/Vulkan/memory_budget.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
+#include <algorithm>
+#include <format>
+
+namespace york::vulkan {
+
+// =====================
+// Budget Creation
+// =====================
+Result<std::unique_ptr<MemoryBudget>> MemoryBudget::Create(const MemoryBudgetCreateInfo &createInfo) {
+  if (!createInfo.Dispatch)
+    return YK_RESULT_FAILURE(Error::Create("MemoryBudget requires a DeviceDispatch"));
+  if (createInfo.RestoreUsage > createInfo.TargetUsage)
+    return YK_RESULT_FAILURE(Error::Create(std::format("RestoreUsage {} is above TargetUsage {}", createInfo.RestoreUsage, createInfo.TargetUsage)));
+
+  const auto &device = *createInfo.Dispatch;
+  const auto &vk = *device.Instance;
+  auto budget = std::unique_ptr<MemoryBudget>(new MemoryBudget());
+  budget->m_CreateInfo = createInfo;
+  // vkGetPhysicalDeviceMemoryProperties2 is core 1.1, it is missing on 1.0 instances
+  budget->m_DriverBudget = createInfo.EnableMemoryBudget && vk.GetPhysicalDeviceMemoryProperties2 &&
+                           device.IsExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+  budget->m_MemoryPriority = createInfo.EnableMemoryPriority && device.IsExtensionEnabled(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME);
+
+  VkPhysicalDeviceMemoryProperties props;
+  vk.GetPhysicalDeviceMemoryProperties(createInfo.PhysicalDevice, &props);
+
+  budget->m_Heaps.resize(props.memoryHeapCount);
+  for (uint32_t i(0); i < props.memoryHeapCount; ++i) {
+    budget->m_Heaps[i].Size = props.memoryHeaps[i].size;
+    budget->m_Heaps[i].Flags = props.memoryHeaps[i].flags;
+  }
+
+  budget->m_TypeHeaps.resize(props.memoryTypeCount);
+  for (uint32_t i(0); i < props.memoryTypeCount; ++i)
+    budget->m_TypeHeaps[i] = props.memoryTypes[i].heapIndex;
+
+  budget->m_RecentChanges.assign(std::max(createInfo.FramesInFlight, 1U), std::vector<int64_t>(props.memoryHeapCount, 0));
+  budget->QueryHeaps();
+
+  return YK_RESULT_SUCCESS(budget);
+}
+
+// =====================
+// Resident Registration
+// =====================
+Result<uint32_t> MemoryBudget::Register(const ResidentCreateInfo &createInfo) {
+  if (createInfo.MemoryType >= m_TypeHeaps.size())
+    return YK_RESULT_FAILURE(Error::Create(std::format("Memory type {} does not exist", createInfo.MemoryType)));
+  if (createInfo.LevelSizes.empty() || createInfo.Level >= createInfo.LevelSizes.size())
+    return YK_RESULT_FAILURE(Error::Create(std::format("Level {} is out of the {} resident levels", createInfo.Level, createInfo.LevelSizes.size())));
+  if (!std::ranges::is_sorted(createInfo.LevelSizes, std::ranges::greater{}))
+    return YK_RESULT_FAILURE(Error::Create("Resident level sizes must not increase"));
+  if (!createInfo.SetLevel)
+    return YK_RESULT_FAILURE(Error::Create("Resident requires a SetLevel callback"));
+
+  uint32_t handle;
+  if (!m_FreeHandles.empty()) {
+    handle = m_FreeHandles.back();
+    m_FreeHandles.pop_back();
+  } else {
+    handle = static_cast<uint32_t>(m_Residents.size());
+    m_Residents.emplace_back();
+  }
+
+  m_Residents[handle] = {
+      .Heap = m_TypeHeaps[createInfo.MemoryType],
+      .LevelSizes = createInfo.LevelSizes,
+      .Level = createInfo.Level,
+      .WantedLevel = createInfo.Level,
+      .Priority = createInfo.Priority,
+      .LastUsedFrame = m_Frame,
+      .SetLevel = createInfo.SetLevel,
+      .Active = true,
+  };
+  m_Heaps[m_Residents[handle].Heap].Registered += createInfo.LevelSizes[createInfo.Level];
+
+  return YK_RESULT_SUCCESS(handle);
+}
+
+void MemoryBudget::Unregister(uint32_t handle) {
+  auto &resident = m_Residents[handle];
+  m_Heaps[resident.Heap].Registered -= resident.LevelSizes[resident.Level];
+  resident = {};
+  m_FreeHandles.push_back(handle);
+}
+
+void MemoryBudget::Request(uint32_t handle, uint32_t level) noexcept {
+  auto &resident = m_Residents[handle];
+  resident.WantedLevel = std::min(level, static_cast<uint32_t>(resident.LevelSizes.size() - 1));
+  resident.LastUsedFrame = m_Frame;
+
+  // Giving memory back needs no room, do it right away
+  if (resident.WantedLevel > resident.Level)
+    ChangeLevel(handle, resident.WantedLevel);
+}
+
+void MemoryBudget::ApplyPriority(VkMemoryAllocateInfo &allocateInfo, VkMemoryPriorityAllocateInfoEXT &priorityInfo, float priority) const noexcept {
+  if (!m_MemoryPriority)
+    return;
+
+  priorityInfo = {
+      .sType = VK_STRUCTURE_TYPE_MEMORY_PRIORITY_ALLOCATE_INFO_EXT,
+      .pNext = allocateInfo.pNext,
+      .priority = std::clamp(priority, 0.0f, 1.0f),
+  };
+  allocateInfo.pNext = &priorityInfo;
+}
+
+// =====================
+// Frame Update
+// =====================
+void MemoryBudget::Update() {
+  YK_PROFILE_FUNCTION();
+  m_Frame++;
+
+  // The driver numbers include the changes of the slot being reused by now
+  std::ranges::fill(m_RecentChanges[m_Frame % m_RecentChanges.size()], 0);
+  QueryHeaps();
+
+  for (uint32_t heap(0); heap < m_Heaps.size(); ++heap) {
+    const auto &info = m_Heaps[heap];
+    if (info.Usage > static_cast<VkDeviceSize>(static_cast<double>(info.Budget) * m_CreateInfo.TargetUsage))
+      Evict(heap);
+    else
+      Restore(heap);
+  }
+}
+
+void MemoryBudget::QueryHeaps() {
+  VkPhysicalDeviceMemoryBudgetPropertiesEXT driver{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT};
+  if (m_DriverBudget) {
+    VkPhysicalDeviceMemoryProperties2 props{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2, .pNext = &driver};
+    m_CreateInfo.Dispatch->Instance->GetPhysicalDeviceMemoryProperties2(m_CreateInfo.PhysicalDevice, &props);
+  }
+
+  for (uint32_t heap(0); heap < m_Heaps.size(); ++heap) {
+    auto &info = m_Heaps[heap];
+    const auto fallback = static_cast<VkDeviceSize>(static_cast<double>(info.Size) * m_CreateInfo.FallbackBudget);
+    if (!m_DriverBudget) {
+      info.Budget = fallback;
+      info.Usage = info.Registered;
+      continue;
+    }
+
+    int64_t pending = 0;
+    for (const auto &changes : m_RecentChanges)
+      pending += changes[heap];
+
+    // A zero budget would demote everything, some drivers leave heaps they do not track at 0
+    info.Budget = driver.heapBudget[heap] > 0 ? driver.heapBudget[heap] : fallback;
+    info.Usage = static_cast<VkDeviceSize>(std::max<int64_t>(static_cast<int64_t>(driver.heapUsage[heap]) + pending, 0));
+  }
+}
+
+// =====================
+// Residency
+// =====================
+void MemoryBudget::ChangeLevel(uint32_t handle, uint32_t level) {
+  auto &resident = m_Residents[handle];
+  const int64_t delta = static_cast<int64_t>(resident.LevelSizes[level]) - static_cast<int64_t>(resident.LevelSizes[resident.Level]);
+
+  resident.SetLevel(level);
+  resident.Level = level;
+
+  auto &info = m_Heaps[resident.Heap];
+  info.Registered = static_cast<VkDeviceSize>(static_cast<int64_t>(info.Registered) + delta);
+  info.Usage = static_cast<VkDeviceSize>(std::max<int64_t>(static_cast<int64_t>(info.Usage) + delta, 0));
+  if (m_DriverBudget)
+    m_RecentChanges[m_Frame % m_RecentChanges.size()][resident.Heap] += delta;
+}
+
+void MemoryBudget::Evict(uint32_t heap) {
+  m_Candidates.clear();
+  for (uint32_t i(0); i < m_Residents.size(); ++i) {
+    const auto &resident = m_Residents[i];
+    if (resident.Active && resident.Heap == heap && resident.Level + 1 < resident.LevelSizes.size())
+      m_Candidates.push_back(i);
+  }
+
+  // Lowest priority first, least recently used first among equals
+  std::ranges::sort(m_Candidates, [&](uint32_t a, uint32_t b) {
+    const auto &ra = m_Residents[a], &rb = m_Residents[b];
+    return ra.Priority != rb.Priority ? ra.Priority < rb.Priority : ra.LastUsedFrame < rb.LastUsedFrame;
+  });
+
+  const auto &info = m_Heaps[heap];
+  const auto target = static_cast<VkDeviceSize>(static_cast<double>(info.Budget) * m_CreateInfo.TargetUsage);
+  for (uint32_t handle : m_Candidates) {
+    auto &resident = m_Residents[handle];
+    while (info.Usage > target && resident.Level + 1 < resident.LevelSizes.size())
+      ChangeLevel(handle, resident.Level + 1);
+    if (info.Usage <= target)
+      return;
+  }
+}
+
+void MemoryBudget::Restore(uint32_t heap) {
+  // Only what was used last frame is streamed back, the rest waits for its next Touch / Request
+  m_Candidates.clear();
+  for (uint32_t i(0); i < m_Residents.size(); ++i) {
+    const auto &resident = m_Residents[i];
+    if (resident.Active && resident.Heap == heap && resident.Level > resident.WantedLevel && resident.LastUsedFrame + 1 >= m_Frame)
+      m_Candidates.push_back(i);
+  }
+
+  std::ranges::sort(m_Candidates, [&](uint32_t a, uint32_t b) {
+    const auto &ra = m_Residents[a], &rb = m_Residents[b];
+    return ra.Priority != rb.Priority ? ra.Priority > rb.Priority : ra.LastUsedFrame > rb.LastUsedFrame;
+  });
+
+  // Stop at the first resource that does not fit so lower priorities never take the room of higher ones
+  const auto &info = m_Heaps[heap];
+  const auto limit = static_cast<VkDeviceSize>(static_cast<double>(info.Budget) * m_CreateInfo.RestoreUsage);
+  VkDeviceSize restored = 0;
+  for (uint32_t handle : m_Candidates) {
+    auto &resident = m_Residents[handle];
+    while (resident.Level > resident.WantedLevel) {
+      const VkDeviceSize grow = resident.LevelSizes[resident.Level - 1] - resident.LevelSizes[resident.Level];
+      if (info.Usage + grow > limit || (restored > 0 && restored + grow > m_CreateInfo.MaxRestoreBytesPerFrame))
+        return;
+      ChangeLevel(handle, resident.Level - 1);
+      restored += grow;
+    }
+  }
+}
+} // namespace york::vulkan
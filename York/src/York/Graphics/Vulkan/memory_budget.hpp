@@ -0,0 +1,133 @@
+#pragma once
+
+/*
+ * GPU Memory Budget and Residency
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "York/Core/result.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
+
+namespace york::vulkan {
+
+// EnableMemoryBudget uses VK_EXT_memory_budget when it is enabled on the Device, without it usage is what was registered
+// here and the budget is FallbackBudget of each heap, since the other processes on the GPU are invisible
+// EnableMemoryPriority uses VK_EXT_memory_priority when it is enabled on the Device, clear it when the memoryPriority
+// feature was not enabled
+// Eviction starts above TargetUsage of the budget, restoring only happens while usage stays under RestoreUsage
+// FramesInFlight is how long a change made here may take to show in the driver numbers (frees wait for the GPU)
+struct MemoryBudgetCreateInfo {
+  VkPhysicalDevice PhysicalDevice = VK_NULL_HANDLE;
+  const DeviceDispatch *Dispatch = nullptr;
+  bool EnableMemoryBudget = true;
+  bool EnableMemoryPriority = true;
+  float TargetUsage = 0.8f;
+  float RestoreUsage = 0.7f;
+  float FallbackBudget = 0.25f;
+  VkDeviceSize MaxRestoreBytesPerFrame = 64ULL << 20;
+  uint32_t FramesInFlight = 2;
+};
+
+// Usage includes the changes made by MemoryBudget that the driver may not report yet
+struct HeapBudget {
+  VkDeviceSize Size = 0;
+  VkDeviceSize Budget = 0;
+  VkDeviceSize Usage = 0;
+  VkDeviceSize Registered = 0;
+  VkMemoryHeapFlags Flags = 0;
+};
+
+// A resource that can give memory back, e.g. a texture dropping its top mips or an inactive animation clip
+// LevelSizes are the bytes used at each level: level 0 is fully resident and sizes decrease (the last one may be 0)
+// SetLevel frees or (re)streams the resource to the given level, Level is the level it is at when registered
+// SetLevel runs on the render thread while the last FramesInFlight frames may still read the memory,
+// so the memory of dropped levels is freed FramesInFlight frames later (e.g. through the frame's deletion queue)
+// Priority is in [0, 1] like VkMemoryPriorityAllocateInfoEXT, lower priorities are demoted first
+struct ResidentCreateInfo {
+  uint32_t MemoryType = 0;
+  std::vector<VkDeviceSize> LevelSizes;
+  uint32_t Level = 0;
+  float Priority = 0.5f;
+  std::function<void(uint32_t level)> SetLevel;
+};
+
+// Usage, on the render thread:
+// Once per frame: budget->Update() (queries the heaps, then demotes or restores resources)
+// When drawing a resource: budget->Touch(handle), only resources used recently are streamed back
+// Allocations: budget->ApplyPriority(allocateInfo, priorityInfo, 1.0f) before vkAllocateMemory
+// Under pressure the lowest priority, least recently used resources are demoted one level at a time
+// until the heap is back under TargetUsage. The overlay shares the GPU, so it gives memory back instead of
+// pushing other processes into paging
+class MemoryBudget {
+public:
+  static Result<std::unique_ptr<MemoryBudget>> Create(const MemoryBudgetCreateInfo &createInfo);
+
+public:
+  void Update();
+
+  Result<uint32_t> Register(const ResidentCreateInfo &createInfo);
+  // The caller frees the memory of the resource, SetLevel is not called
+  void Unregister(uint32_t handle);
+
+  void Touch(uint32_t handle) noexcept { m_Residents[handle].LastUsedFrame = m_Frame; }
+  // Level the resource is streamed back to when there is room, also counts as a use
+  void Request(uint32_t handle, uint32_t level = 0) noexcept;
+  void SetPriority(uint32_t handle, float priority) noexcept { m_Residents[handle].Priority = priority; }
+  uint32_t GetLevel(uint32_t handle) const noexcept { return m_Residents[handle].Level; }
+
+  // Chains priorityInfo into allocateInfo when VK_EXT_memory_priority is enabled, otherwise leaves both untouched
+  // priorityInfo must outlive the vkAllocateMemory call
+  void ApplyPriority(VkMemoryAllocateInfo &allocateInfo, VkMemoryPriorityAllocateInfoEXT &priorityInfo, float priority) const noexcept;
+
+  bool HasDriverBudget() const noexcept { return m_DriverBudget; }
+  bool HasMemoryPriority() const noexcept { return m_MemoryPriority; }
+  uint32_t GetHeapIndex(uint32_t memoryType) const noexcept { return m_TypeHeaps[memoryType]; }
+  const std::vector<HeapBudget> &GetHeaps() const noexcept { return m_Heaps; }
+  bool IsOverBudget(uint32_t heap) const noexcept { return m_Heaps[heap].Usage > m_Heaps[heap].Budget; }
+
+private:
+  MemoryBudget() = default;
+
+  void QueryHeaps();
+  void Evict(uint32_t heap);
+  void Restore(uint32_t heap);
+  // Moves a resource to level and records the size change for the heap
+  void ChangeLevel(uint32_t handle, uint32_t level);
+
+public:
+  ~MemoryBudget() = default;
+  MemoryBudget(const MemoryBudget &) = delete;
+  MemoryBudget &operator=(const MemoryBudget &) = delete;
+
+private:
+  struct Resident {
+    uint32_t Heap = 0;
+    std::vector<VkDeviceSize> LevelSizes;
+    uint32_t Level = 0;
+    uint32_t WantedLevel = 0;
+    float Priority = 0.0f;
+    uint64_t LastUsedFrame = 0;
+    std::function<void(uint32_t)> SetLevel;
+    bool Active = false;
+  };
+
+private:
+  MemoryBudgetCreateInfo m_CreateInfo;
+  bool m_DriverBudget = false;
+  bool m_MemoryPriority = false;
+  uint64_t m_Frame = 0;
+
+  std::vector<HeapBudget> m_Heaps;
+  std::vector<uint32_t> m_TypeHeaps;
+  // Signed size changes per heap over the last FramesInFlight frames, [frame % FramesInFlight][heap]
+  std::vector<std::vector<int64_t>> m_RecentChanges;
+
+  std::vector<Resident> m_Residents;
+  std::vector<uint32_t> m_FreeHandles;
+  std::vector<uint32_t> m_Candidates;
+};
+} // namespace york::vulkan
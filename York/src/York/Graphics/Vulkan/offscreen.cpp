@@ -0,0 +1,100 @@
+#include "York/Graphics/Vulkan/offscreen.hpp"
+#include "York/Graphics/Vulkan/helpers.hpp"
+#include "York/Core/error.hpp"
+#include <algorithm>
+#include <format>
+
+namespace york::vulkan {
+
+// =====================
+// Target Creation
+// =====================
+Result<std::unique_ptr<OffscreenTarget>> OffscreenTarget::Create(const OffscreenTargetCreateInfo &createInfo) {
+  if (!createInfo.Dispatch)
+    return YK_RESULT_FAILURE(Error::Create("OffscreenTarget requires a DeviceDispatch"));
+
+  const auto &vk = *createInfo.Dispatch;
+  auto target = std::unique_ptr<OffscreenTarget>(new OffscreenTarget());
+  target->m_Dispatch = createInfo.Dispatch;
+  target->m_Extent = createInfo.Extent;
+  target->m_Format = createInfo.Format;
+  target->m_Images.resize(std::max(createInfo.ImageCount, 1U));
+
+  for (auto &image : target->m_Images) {
+    const VkImageCreateInfo imageCI{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = {},
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = createInfo.Format,
+        .extent = {createInfo.Extent.width, createInfo.Extent.height, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = createInfo.Usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+
+    if (auto code = vk.CreateImage(vk.Device, &imageCI, nullptr, &image.Image); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateImage failed: {}", ToString(code))));
+
+    VkMemoryRequirements requirements;
+    vk.GetImageMemoryRequirements(vk.Device, image.Image, &requirements);
+
+    auto memoryType = FindMemoryType(*vk.Instance, createInfo.PhysicalDevice, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!memoryType)
+      return YK_RESULT_FAILURE(Error::Create("No device local memory type for offscreen image"));
+
+    VkMemoryAllocateInfo allocateInfo{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = nullptr,
+        .allocationSize = requirements.size,
+        .memoryTypeIndex = *memoryType,
+    };
+    // Render targets are written every frame, streamed resources should be paged out before them
+    VkMemoryPriorityAllocateInfoEXT priorityInfo{};
+    if (createInfo.Budget)
+      createInfo.Budget->ApplyPriority(allocateInfo, priorityInfo, 1.0f);
+
+    if (auto code = vk.AllocateMemory(vk.Device, &allocateInfo, nullptr, &image.Memory); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkAllocateMemory failed: {}", ToString(code))));
+
+    if (auto code = vk.BindImageMemory(vk.Device, image.Image, image.Memory, 0); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkBindImageMemory failed: {}", ToString(code))));
+
+    const VkImageViewCreateInfo viewCI{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = {},
+        .image = image.Image,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = createInfo.Format,
+        .components = {},
+        .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1},
+    };
+
+    if (auto code = vk.CreateImageView(vk.Device, &viewCI, nullptr, &image.View); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateImageView failed: {}", ToString(code))));
+  }
+
+  return YK_RESULT_SUCCESS(target);
+}
+
+// =====================
+// Destructor
+// =====================
+OffscreenTarget::~OffscreenTarget() {
+  for (auto &image : m_Images) {
+    if (image.View)
+      m_Dispatch->DestroyImageView(m_Dispatch->Device, image.View, nullptr);
+    if (image.Image)
+      m_Dispatch->DestroyImage(m_Dispatch->Device, image.Image, nullptr);
+    if (image.Memory)
+      m_Dispatch->FreeMemory(m_Dispatch->Device, image.Memory, nullptr);
+  }
+}
+} // namespace york::vulkan
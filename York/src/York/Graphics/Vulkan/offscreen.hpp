@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+ * Offscreen Color Targets for Headless Rendering
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <memory>
+#include <vector>
+#include "York/Core/result.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
+#include "York/Graphics/Vulkan/memory_budget.hpp"
+
+namespace york::vulkan {
+
+// Usage must keep VK_IMAGE_USAGE_TRANSFER_SRC_BIT to allow ReadbackRing copies
+// Budget is optional, with it the images get the highest memory priority
+struct OffscreenTargetCreateInfo {
+  VkPhysicalDevice PhysicalDevice = VK_NULL_HANDLE;
+  const DeviceDispatch *Dispatch = nullptr;
+  const MemoryBudget *Budget = nullptr;
+  VkExtent2D Extent{};
+  VkFormat Format = VK_FORMAT_R8G8B8A8_UNORM;
+  uint32_t ImageCount = 2;
+  VkImageUsageFlags Usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+};
+
+// Swapchain stand-in when there is no presentable surface
+// Images are rotated round-robin, the caller synchronizes reuse with its frames in flight
+class OffscreenTarget {
+public:
+  static Result<std::unique_ptr<OffscreenTarget>> Create(const OffscreenTargetCreateInfo &createInfo);
+
+public:
+  uint32_t AcquireNextImage() noexcept {
+    m_Current = (m_Current + 1) % static_cast<uint32_t>(m_Images.size());
+    return m_Current;
+  }
+
+private:
+  OffscreenTarget() = default;
+
+public:
+  ~OffscreenTarget();
+  OffscreenTarget(const OffscreenTarget &) = delete;
+  OffscreenTarget &operator=(const OffscreenTarget &) = delete;
+
+public:
+  uint32_t GetImageCount() const noexcept { return static_cast<uint32_t>(m_Images.size()); }
+  VkImage GetImage(uint32_t index) const noexcept { return m_Images[index].Image; }
+  VkImageView GetView(uint32_t index) const noexcept { return m_Images[index].View; }
+  VkExtent2D GetExtent() const noexcept { return m_Extent; }
+  VkFormat GetFormat() const noexcept { return m_Format; }
+
+private:
+  struct Target {
+    VkImage Image = VK_NULL_HANDLE;
+    VkImageView View = VK_NULL_HANDLE;
+    VkDeviceMemory Memory = VK_NULL_HANDLE;
+  };
+
+private:
+  const DeviceDispatch *m_Dispatch = nullptr;
+  VkExtent2D m_Extent{};
+  VkFormat m_Format = VK_FORMAT_UNDEFINED;
+  uint32_t m_Current = 0;
+  std::vector<Target> m_Images;
+};
+} // namespace york::vulkan
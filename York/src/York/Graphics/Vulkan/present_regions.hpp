@@ -0,0 +1,41 @@
+#pragma once
+
+/*
+ * VK_KHR_incremental_present Helpers
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <vector>
+#include "York/Core/damage.hpp"
+
+namespace york::vulkan {
+
+// Translates window damage into VkPresentRegionsKHR for a single swapchain
+// Usage: presentInfo.pNext = regions.Build(window->GetDamage()), requires VK_KHR_incremental_present on the Device
+// Build returns nullptr for full damage, the presentation engine then updates the whole image as usual
+class PresentRegions {
+public:
+  const VkPresentRegionsKHR *Build(const DamageTracker &damage) {
+    if (damage.IsEmpty() || damage.IsFull())
+      return nullptr;
+
+    m_Rects.clear();
+    for (const auto &rect : damage.GetRects())
+      m_Rects.push_back({.offset = {rect.X, rect.Y}, .extent = {rect.Width, rect.Height}, .layer = 0});
+
+    m_Region = {.rectangleCount = static_cast<uint32_t>(m_Rects.size()), .pRectangles = m_Rects.data()};
+    m_Regions = {
+        .sType = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR,
+        .pNext = nullptr,
+        .swapchainCount = 1,
+        .pRegions = &m_Region,
+    };
+    return &m_Regions;
+  }
+
+private:
+  std::vector<VkRectLayerKHR> m_Rects;
+  VkPresentRegionKHR m_Region{};
+  VkPresentRegionsKHR m_Regions{};
+};
+} // namespace york::vulkan
@@ -0,0 +1,173 @@
+#include "York/Graphics/Vulkan/readback.hpp"
+#include "York/Graphics/Vulkan/helpers.hpp"
+#include "York/Core/error.hpp"
+#include <algorithm>
+#include <format>
+
+namespace york::vulkan {
+
+// =====================
+// Ring Creation
+// =====================
+Result<std::unique_ptr<ReadbackRing>> ReadbackRing::Create(const ReadbackRingCreateInfo &createInfo) {
+  if (!createInfo.Dispatch)
+    return YK_RESULT_FAILURE(Error::Create("ReadbackRing requires a DeviceDispatch"));
+
+  const auto &vk = *createInfo.Dispatch;
+  auto ring = std::unique_ptr<ReadbackRing>(new ReadbackRing());
+  ring->m_Dispatch = createInfo.Dispatch;
+  ring->m_SlotSize = createInfo.SlotSize;
+  ring->m_Slots.resize(std::max(createInfo.SlotCount, 1U));
+
+  for (auto &slot : ring->m_Slots) {
+    const VkBufferCreateInfo bufferCI{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = {},
+        .size = createInfo.SlotSize,
+        .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+    };
+
+    if (auto code = vk.CreateBuffer(vk.Device, &bufferCI, nullptr, &slot.Buffer); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateBuffer failed: {}", ToString(code))));
+
+    VkMemoryRequirements requirements;
+    vk.GetBufferMemoryRequirements(vk.Device, slot.Buffer, &requirements);
+
+    // Cached memory makes CPU reads fast, coherent is only a fallback
+    auto memoryType = FindMemoryType(*vk.Instance, createInfo.PhysicalDevice, requirements.memoryTypeBits,
+                                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    if (!memoryType) {
+      memoryType = FindMemoryType(*vk.Instance, createInfo.PhysicalDevice, requirements.memoryTypeBits,
+                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+      ring->m_Coherent = true;
+    }
+    if (!memoryType)
+      return YK_RESULT_FAILURE(Error::Create("No host visible memory type for readback buffer"));
+
+    const VkMemoryAllocateInfo allocateInfo{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = nullptr,
+        .allocationSize = requirements.size,
+        .memoryTypeIndex = *memoryType,
+    };
+
+    if (auto code = vk.AllocateMemory(vk.Device, &allocateInfo, nullptr, &slot.Memory); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkAllocateMemory failed: {}", ToString(code))));
+
+    if (auto code = vk.BindBufferMemory(vk.Device, slot.Buffer, slot.Memory, 0); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkBindBufferMemory failed: {}", ToString(code))));
+
+    void *mapped = nullptr;
+    if (auto code = vk.MapMemory(vk.Device, slot.Memory, 0, VK_WHOLE_SIZE, 0, &mapped); code != VK_SUCCESS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("vkMapMemory failed: {}", ToString(code))));
+    slot.Mapped = static_cast<std::byte *>(mapped);
+  }
+
+  return YK_RESULT_SUCCESS(ring);
+}
+
+// =====================
+// Runtime Operations
+// =====================
+Result<uint32_t> ReadbackRing::RecordCopy(VkCommandBuffer cmd, VkImage image, VkExtent2D extent, VkFence fence, uint32_t bytesPerTexel) {
+  const VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * bytesPerTexel;
+  if (size > m_SlotSize)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Readback of {} bytes exceeds slot size {}", size, m_SlotSize)));
+
+  const uint32_t count = static_cast<uint32_t>(m_Slots.size());
+  for (uint32_t i(0); i < count; ++i) {
+    const uint32_t index = (m_Next + i) % count;
+    auto &slot = m_Slots[index];
+    if (slot.State != SlotState::Free)
+      continue;
+
+    const VkBufferImageCopy region{
+        .bufferOffset = 0,
+        .bufferRowLength = 0,
+        .bufferImageHeight = 0,
+        .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+        .imageOffset = {0, 0, 0},
+        .imageExtent = {extent.width, extent.height, 1},
+    };
+    m_Dispatch->CmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.Buffer, 1, &region);
+
+    // Make the transfer write visible to host reads once the fence signals
+    const VkBufferMemoryBarrier2 barrier{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+        .pNext = nullptr,
+        .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+        .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        .dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT,
+        .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = slot.Buffer,
+        .offset = 0,
+        .size = size,
+    };
+    const VkDependencyInfo dependency{
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .pNext = nullptr,
+        .dependencyFlags = {},
+        .memoryBarrierCount = 0,
+        .pMemoryBarriers = nullptr,
+        .bufferMemoryBarrierCount = 1,
+        .pBufferMemoryBarriers = &barrier,
+        .imageMemoryBarrierCount = 0,
+        .pImageMemoryBarriers = nullptr,
+    };
+    m_Dispatch->CmdPipelineBarrier2(cmd, &dependency);
+
+    slot.Fence = fence;
+    slot.Size = size;
+    slot.State = SlotState::Pending;
+    m_Next = (index + 1) % count;
+    return index;
+  }
+
+  return YK_RESULT_FAILURE(Error::Create("Every readback slot is in use"));
+}
+
+std::optional<std::span<const std::byte>> ReadbackRing::TryRead(uint32_t slot) {
+  auto &entry = m_Slots[slot];
+  if (entry.State == SlotState::Free)
+    return std::nullopt;
+
+  if (entry.State == SlotState::Pending) {
+    if (m_Dispatch->GetFenceStatus(m_Dispatch->Device, entry.Fence) != VK_SUCCESS)
+      return std::nullopt;
+
+    if (!m_Coherent) {
+      const VkMappedMemoryRange range{
+          .sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+          .pNext = nullptr,
+          .memory = entry.Memory,
+          .offset = 0,
+          .size = VK_WHOLE_SIZE,
+      };
+      m_Dispatch->InvalidateMappedMemoryRanges(m_Dispatch->Device, 1, &range);
+    }
+    entry.State = SlotState::Ready;
+  }
+
+  return std::span<const std::byte>(entry.Mapped, entry.Size);
+}
+
+// =====================
+// Destructor
+// =====================
+ReadbackRing::~ReadbackRing() {
+  for (auto &slot : m_Slots) {
+    if (slot.Mapped)
+      m_Dispatch->UnmapMemory(m_Dispatch->Device, slot.Memory);
+    if (slot.Buffer)
+      m_Dispatch->DestroyBuffer(m_Dispatch->Device, slot.Buffer, nullptr);
+    if (slot.Memory)
+      m_Dispatch->FreeMemory(m_Dispatch->Device, slot.Memory, nullptr);
+  }
+}
+} // namespace york::vulkan
@@ -0,0 +1,70 @@
+#pragma once
+
+/*
+ * Pooled GPU -> CPU Image Readback
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include "York/Core/result.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
+
+namespace york::vulkan {
+
+// SlotSize must hold the largest copied image (width * height * bytes per texel)
+struct ReadbackRingCreateInfo {
+  VkPhysicalDevice PhysicalDevice = VK_NULL_HANDLE;
+  const DeviceDispatch *Dispatch = nullptr;
+  VkDeviceSize SlotSize = 0;
+  uint32_t SlotCount = 3;
+};
+
+// Usage:
+// auto slot = ring->RecordCopy(cmd, image, extent, fence) with image in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+// Submit cmd signaling fence, then poll ring->TryRead(*slot) on later frames and ring->Release(*slot) when done
+// Buffers stay persistently mapped, slots are recycled instead of reallocated per readback
+class ReadbackRing {
+public:
+  static Result<std::unique_ptr<ReadbackRing>> Create(const ReadbackRingCreateInfo &createInfo);
+
+public:
+  // Fails when every slot is still pending or held by the caller
+  Result<uint32_t> RecordCopy(VkCommandBuffer cmd, VkImage image, VkExtent2D extent, VkFence fence, uint32_t bytesPerTexel = 4);
+
+  // std::nullopt until the fence passed to RecordCopy is signaled
+  std::optional<std::span<const std::byte>> TryRead(uint32_t slot);
+
+  void Release(uint32_t slot) noexcept { m_Slots[slot].State = SlotState::Free; }
+
+private:
+  ReadbackRing() = default;
+
+public:
+  ~ReadbackRing();
+  ReadbackRing(const ReadbackRing &) = delete;
+  ReadbackRing &operator=(const ReadbackRing &) = delete;
+
+private:
+  enum class SlotState { Free, Pending, Ready };
+
+  struct Slot {
+    VkBuffer Buffer = VK_NULL_HANDLE;
+    VkDeviceMemory Memory = VK_NULL_HANDLE;
+    std::byte *Mapped = nullptr;
+    VkFence Fence = VK_NULL_HANDLE;
+    VkDeviceSize Size = 0;
+    SlotState State = SlotState::Free;
+  };
+
+private:
+  const DeviceDispatch *m_Dispatch = nullptr;
+  VkDeviceSize m_SlotSize = 0;
+  bool m_Coherent = false;
+  uint32_t m_Next = 0;
+  std::vector<Slot> m_Slots;
+};
+} // namespace york::vulkan
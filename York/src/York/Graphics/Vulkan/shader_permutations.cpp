@@ -0,0 +1,160 @@
+#include "York/Graphics/Vulkan/shader_permutations.hpp"
+#include "York/Graphics/Vulkan/helpers.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
+#include <algorithm>
+#include <format>
+#include <string_view>
+
+namespace york::vulkan {
+
+static uint64_t HashName(std::string_view name) noexcept {
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+static uint64_t Mix(uint64_t value) noexcept {
+  // splitmix64 finalizer
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+// =====================
+// Variants Creation
+// =====================
+Result<std::unique_ptr<PipelineVariants>> PipelineVariants::Create(const PipelineVariantsCreateInfo &createInfo) {
+  if (!createInfo.Dispatch)
+    return YK_RESULT_FAILURE(Error::Create("PipelineVariants requires a DeviceDispatch"));
+
+  const auto &vk = *createInfo.Dispatch;
+  auto variants = std::unique_ptr<PipelineVariants>(new PipelineVariants());
+  variants->m_Dispatch = createInfo.Dispatch;
+
+  const VkPipelineCacheCreateInfo cacheCI{
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = {},
+      .initialDataSize = createInfo.InitialCacheData.size(),
+      .pInitialData = createInfo.InitialCacheData.data(),
+  };
+
+  if (auto code = vk.CreatePipelineCache(vk.Device, &cacheCI, nullptr, &variants->m_Cache); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkCreatePipelineCache failed: {}", ToString(code))));
+
+  return YK_RESULT_SUCCESS(variants);
+}
+
+uint32_t PipelineVariants::AddFamily(const char *name, std::span<const ShaderFeature> features, std::span<const uint32_t> offsets,
+                                     uint32_t totalBits, PipelineBuilder builder) {
+  Family family{
+      .Name = name,
+      .NameHash = HashName(name),
+      .KeyMask = totalBits >= 64 ? ~0ULL : (1ULL << totalBits) - 1,
+      .Possible = totalBits >= 64 ? UINT64_MAX : 1ULL << totalBits,
+      .Features = {features.begin(), features.end()},
+      .Offsets = {offsets.begin(), offsets.end()},
+      .Builder = std::move(builder),
+  };
+
+  // Every constant is a 32-bit value, laid out in feature order
+  for (uint32_t i(0); i < features.size(); ++i)
+    family.Entries.push_back({.constantID = features[i].ConstantID, .offset = i * 4, .size = 4});
+
+  m_Families.push_back(std::move(family));
+  return static_cast<uint32_t>(m_Families.size() - 1);
+}
+
+// =====================
+// Variant Lookup
+// =====================
+uint64_t PipelineVariants::GetVariantHash(uint32_t family, uint64_t key) const noexcept {
+  return Mix(m_Families[family].NameHash ^ Mix(key));
+}
+
+Result<VkPipeline> PipelineVariants::Get(uint32_t family, uint64_t key) {
+  if (family >= m_Families.size())
+    return YK_RESULT_FAILURE(Error::Create(std::format("Pipeline family {} does not exist", family)));
+
+  auto &info = m_Families[family];
+  if (key & ~info.KeyMask)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Permutation key {:#x} has bits outside of family \"{}\"", key, info.Name)));
+
+  if (auto it = m_Pipelines.find({family, key}); it != m_Pipelines.end())
+    return it->second;
+
+  YK_PROFILE_FUNCTION();
+  m_Values.resize(info.Features.size());
+  for (uint32_t i(0); i < info.Features.size(); ++i) {
+    const uint64_t mask = (1ULL << info.Features[i].Bits) - 1;
+    m_Values[i] = static_cast<uint32_t>((key >> info.Offsets[i]) & mask);
+  }
+
+  const VkSpecializationInfo specialization{
+      .mapEntryCount = static_cast<uint32_t>(info.Entries.size()),
+      .pMapEntries = info.Entries.data(),
+      .dataSize = m_Values.size() * sizeof(uint32_t),
+      .pData = m_Values.data(),
+  };
+
+  VkPipeline pipeline = VK_NULL_HANDLE;
+  if (auto code = info.Builder(specialization, m_Cache, pipeline); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Building variant {:#x} of \"{}\" failed: {}", key, info.Name, ToString(code))));
+
+  m_Pipelines.emplace(VariantKey{family, key}, pipeline);
+  info.Instantiated++;
+  return pipeline;
+}
+
+// =====================
+// Reporting
+// =====================
+std::vector<uint64_t> PipelineVariants::GetInstantiatedKeys(uint32_t family) const {
+  std::vector<uint64_t> keys;
+  for (const auto &[variant, pipeline] : m_Pipelines) {
+    if (variant.Family == family)
+      keys.push_back(variant.Key);
+  }
+  std::ranges::sort(keys);
+  return keys;
+}
+
+std::vector<VariantStats> PipelineVariants::GetStats() const {
+  std::vector<VariantStats> stats;
+  for (const auto &family : m_Families)
+    stats.push_back({.Family = family.Name, .Instantiated = family.Instantiated, .Possible = family.Possible});
+  return stats;
+}
+
+Result<std::vector<std::byte>> PipelineVariants::GetCacheData() const {
+  const auto &vk = *m_Dispatch;
+  size_t size = 0;
+  if (auto code = vk.GetPipelineCacheData(vk.Device, m_Cache, &size, nullptr); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkGetPipelineCacheData failed: {}", ToString(code))));
+
+  std::vector<std::byte> data(size);
+  if (auto code = vk.GetPipelineCacheData(vk.Device, m_Cache, &size, data.data()); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkGetPipelineCacheData failed: {}", ToString(code))));
+  data.resize(size);
+
+  return YK_RESULT_SUCCESS(data);
+}
+
+// =====================
+// Destructor
+// =====================
+PipelineVariants::~PipelineVariants() {
+  for (const auto &[variant, pipeline] : m_Pipelines)
+    m_Dispatch->DestroyPipeline(m_Dispatch->Device, pipeline, nullptr);
+  if (m_Cache)
+    m_Dispatch->DestroyPipelineCache(m_Dispatch->Device, m_Cache, nullptr);
+}
+} // namespace york::vulkan
@@ -0,0 +1,185 @@
+#pragma once
+
+/*
+ * Shader Permutations through Specialization Constants
+ */
+
+#include <vulkan/vulkan_core.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "York/Core/result.hpp"
+#include "York/Graphics/Vulkan/dispatch.hpp"
+
+namespace york::vulkan {
+
+// One specialization constant of a shader family, e.g. SKINNED (1 bit) or QUALITY (2 bits for 4 tiers)
+// The shader declares it as layout(constant_id = ConstantID) const uint, booleans are 0 / 1
+struct ShaderFeature {
+  const char *Name = nullptr;
+  uint32_t ConstantID = 0;
+  uint32_t Bits = 1;
+};
+
+// Compile-time layout packing the value of every feature into a 64-bit permutation key
+// Usage:
+// enum MeshFeature : uint32_t { SKINNED, MORPHS, ALPHA_MASK, QUALITY };
+// inline constexpr ShaderFeatureSet MESH_FEATURES{{{"SKINNED", 0}, {"MORPHS", 1}, {"ALPHA_MASK", 2}, {"QUALITY", 3, 2}}};
+// constexpr uint64_t key = MESH_FEATURES.MakeKey({{SKINNED, 1}, {QUALITY, 2}});
+// Invalid layouts (bad widths, duplicated constant ids, more than 64 bits) fail to compile
+template <size_t N>
+class ShaderFeatureSet {
+public:
+  consteval ShaderFeatureSet(const ShaderFeature (&features)[N]) {
+    uint32_t offset = 0;
+    for (size_t i(0); i < N; ++i) {
+      if (features[i].Bits == 0 || features[i].Bits > 32)
+        throw "Shader feature width must be 1 to 32 bits";
+      for (size_t j(0); j < i; ++j) {
+        if (features[j].ConstantID == features[i].ConstantID)
+          throw "Shader features must use distinct constant ids";
+      }
+
+      m_Features[i] = features[i];
+      m_Offsets[i] = offset;
+      offset += features[i].Bits;
+    }
+
+    if (offset > 64)
+      throw "Shader feature set does not fit a 64-bit key";
+    m_TotalBits = offset;
+  }
+
+  // Values wider than the feature are truncated to its bits
+  constexpr uint64_t Set(uint64_t key, size_t feature, uint32_t value) const noexcept {
+    const uint64_t mask = FieldMask(feature);
+    return (key & ~(mask << m_Offsets[feature])) | ((static_cast<uint64_t>(value) & mask) << m_Offsets[feature]);
+  }
+
+  constexpr uint32_t Get(uint64_t key, size_t feature) const noexcept {
+    return static_cast<uint32_t>((key >> m_Offsets[feature]) & FieldMask(feature));
+  }
+
+  constexpr uint64_t MakeKey(std::initializer_list<std::pair<size_t, uint32_t>> values) const noexcept {
+    uint64_t key = 0;
+    for (const auto &[feature, value] : values)
+      key = Set(key, feature, value);
+    return key;
+  }
+
+  // Every combination the layout can express, the number of variants actually built is usually far lower
+  constexpr uint64_t GetPermutationCount() const noexcept { return m_TotalBits >= 64 ? UINT64_MAX : 1ULL << m_TotalBits; }
+
+  constexpr std::span<const ShaderFeature, N> GetFeatures() const noexcept { return m_Features; }
+  constexpr std::span<const uint32_t, N> GetOffsets() const noexcept { return m_Offsets; }
+  constexpr uint32_t GetTotalBits() const noexcept { return m_TotalBits; }
+
+private:
+  constexpr uint64_t FieldMask(size_t feature) const noexcept { return (1ULL << m_Features[feature].Bits) - 1; }
+
+private:
+  std::array<ShaderFeature, N> m_Features{};
+  std::array<uint32_t, N> m_Offsets{};
+  uint32_t m_TotalBits = 0;
+};
+
+// InitialCacheData is a blob from a previous PipelineVariants::GetCacheData, it is ignored by the driver when stale
+struct PipelineVariantsCreateInfo {
+  const DeviceDispatch *Dispatch = nullptr;
+  std::span<const std::byte> InitialCacheData;
+};
+
+// Instantiated is the number of variants built so far, Possible the number the feature layout can express
+struct VariantStats {
+  std::string Family;
+  uint64_t Instantiated = 0;
+  uint64_t Possible = 0;
+};
+
+// Builds a pipeline of the family with the given specialization, through the given cache
+using PipelineBuilder = std::function<VkResult(const VkSpecializationInfo &specialization, VkPipelineCache cache, VkPipeline &pipeline)>;
+
+// Pipelines are built lazily per (family, permutation key) at pipeline-creation time, never per draw
+// Feature values reach the shader as specialization constants, so the compiler folds the branches away
+// and a single SPIR-V module serves every variant of the family
+// Usage:
+// auto mesh = variants->AddFamily("mesh", MESH_FEATURES, [&](const VkSpecializationInfo &spec, VkPipelineCache cache, VkPipeline &out) {
+//   stages[i].pSpecializationInfo = &spec; return dispatch.CreateGraphicsPipelines(device, cache, 1, &pipelineCI, nullptr, &out); });
+// On material load: variants->Get(mesh, material.Key)
+// Not thread safe, pipelines are created on the loading thread
+class PipelineVariants {
+public:
+  static Result<std::unique_ptr<PipelineVariants>> Create(const PipelineVariantsCreateInfo &createInfo);
+
+public:
+  template <size_t N>
+  uint32_t AddFamily(const char *name, const ShaderFeatureSet<N> &features, PipelineBuilder builder) {
+    return AddFamily(name, features.GetFeatures(), features.GetOffsets(), features.GetTotalBits(), std::move(builder));
+  }
+
+  // Builds the variant the first time a key is requested
+  Result<VkPipeline> Get(uint32_t family, uint64_t key);
+
+  // Stable across runs (family name and key), e.g. to record the variants a scene uses and prebuild them on load
+  uint64_t GetVariantHash(uint32_t family, uint64_t key) const noexcept;
+
+  std::vector<uint64_t> GetInstantiatedKeys(uint32_t family) const;
+  uint64_t GetVariantCount() const noexcept { return m_Pipelines.size(); }
+  std::vector<VariantStats> GetStats() const;
+
+  // Serialized VkPipelineCache, to pass back as InitialCacheData on the next run
+  Result<std::vector<std::byte>> GetCacheData() const;
+
+private:
+  PipelineVariants() = default;
+
+  uint32_t AddFamily(const char *name, std::span<const ShaderFeature> features, std::span<const uint32_t> offsets, uint32_t totalBits,
+                     PipelineBuilder builder);
+
+public:
+  ~PipelineVariants();
+  PipelineVariants(const PipelineVariants &) = delete;
+  PipelineVariants &operator=(const PipelineVariants &) = delete;
+
+private:
+  // Map entries are key independent, only Values change per variant
+  struct Family {
+    std::string Name;
+    uint64_t NameHash = 0;
+    uint64_t KeyMask = 0;
+    uint64_t Possible = 0;
+    uint64_t Instantiated = 0;
+    std::vector<ShaderFeature> Features;
+    std::vector<uint32_t> Offsets;
+    std::vector<VkSpecializationMapEntry> Entries;
+    PipelineBuilder Builder;
+  };
+
+  struct VariantKey {
+    uint32_t Family = 0;
+    uint64_t Key = 0;
+
+    bool operator==(const VariantKey &) const = default;
+  };
+
+  struct VariantKeyHash {
+    const PipelineVariants *Owner = nullptr;
+    size_t operator()(const VariantKey &variant) const noexcept { return Owner->GetVariantHash(variant.Family, variant.Key); }
+  };
+
+private:
+  const DeviceDispatch *m_Dispatch = nullptr;
+  VkPipelineCache m_Cache = VK_NULL_HANDLE;
+  std::vector<Family> m_Families;
+  std::unordered_map<VariantKey, VkPipeline, VariantKeyHash> m_Pipelines{0, VariantKeyHash{this}};
+  std::vector<uint32_t> m_Values;
+};
+} // namespace york::vulkan
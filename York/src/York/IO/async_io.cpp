@@ -0,0 +1,361 @@
+#include "York/IO/async_io.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define YORK_IO_URING 1
+#else
+#define YORK_IO_URING 0
+#endif
+
+namespace york::io {
+
+// Keeps every read inside the 32-bit length of an io_uring submission
+static constexpr size_t MAX_READ_SIZE = size_t{1} << 30;
+
+// =====================
+// File
+// =====================
+Result<std::unique_ptr<File>> File::Open(const std::string &path) {
+  auto file = std::unique_ptr<File>(new File());
+  file->m_Handle = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file->m_Handle < 0)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Failed to open {}: {}", path, std::strerror(errno))));
+
+  struct stat info;
+  if (fstat(file->m_Handle, &info) != 0)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Failed to stat {}: {}", path, std::strerror(errno))));
+  file->m_Size = static_cast<uint64_t>(info.st_size);
+
+  return YK_RESULT_SUCCESS(file);
+}
+
+File::~File() {
+  if (m_Handle >= 0)
+    close(m_Handle);
+}
+
+// =====================
+// Read Operation
+// =====================
+void ReadOperation::await_suspend(std::coroutine_handle<> handle) {
+  m_Awaiter = handle;
+  m_Context.Submit(this);
+}
+
+Result<size_t> ReadOperation::await_resume() const {
+  if (m_Result < 0)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Read failed: {}", std::strerror(static_cast<int>(-m_Result)))));
+  return static_cast<size_t>(m_Result);
+}
+
+// =====================
+// Context Creation
+// =====================
+Result<std::unique_ptr<Context>> Context::Create(const ContextCreateInfo &createInfo) {
+  if (!createInfo.Jobs)
+    return YK_RESULT_FAILURE(Error::Create("io::Context requires a JobSystem"));
+
+  auto context = std::unique_ptr<Context>(new Context());
+  context->m_Jobs = createInfo.Jobs;
+
+  if (!createInfo.ForceThreadPool && context->SetupRing(createInfo)) {
+    try {
+      context->m_RingThread = std::thread(&Context::RingLoop, context.get());
+      context->m_Backend = Backend::IOUring;
+      return YK_RESULT_SUCCESS(context);
+    } catch (const std::system_error &) {
+      context->CloseRing();
+    }
+  }
+
+  // Blocking reads get their own workers so they never stall decoding on the shared JobSystem
+  auto fallback = JobSystem::Create({.ThreadCount = std::max(createInfo.FallbackThreads, 1U)});
+  if (!fallback)
+    return YK_RESULT_FAILURE(fallback.error());
+  context->m_Fallback = std::move(*fallback);
+  context->m_Backend = Backend::ThreadPool;
+
+  return YK_RESULT_SUCCESS(context);
+}
+
+bool Context::SetupRing(const ContextCreateInfo &createInfo) {
+#if YORK_IO_URING
+  io_uring_params params{};
+  const int handle = static_cast<int>(syscall(__NR_io_uring_setup, std::max(createInfo.QueueDepth, 2U), &params));
+  if (handle < 0)
+    return false;
+  m_Ring.Handle = handle;
+
+  // IORING_OP_READ needs Linux 5.6, IORING_FEAT_FAST_POLL (5.7) is the closest feature bit to check it
+  if (!(params.features & IORING_FEAT_FAST_POLL)) {
+    CloseRing();
+    return false;
+  }
+
+  m_Ring.SQMappingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  m_Ring.CQMappingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single)
+    m_Ring.SQMappingSize = m_Ring.CQMappingSize = std::max(m_Ring.SQMappingSize, m_Ring.CQMappingSize);
+
+  auto map = [&](size_t size, off_t offset) -> void * {
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle, offset);
+    return mapping == MAP_FAILED ? nullptr : mapping;
+  };
+
+  m_Ring.SQMapping = map(m_Ring.SQMappingSize, IORING_OFF_SQ_RING);
+  m_Ring.CQMapping = single ? m_Ring.SQMapping : map(m_Ring.CQMappingSize, IORING_OFF_CQ_RING);
+  m_Ring.SQEMappingSize = params.sq_entries * sizeof(io_uring_sqe);
+  m_Ring.SQEMapping = map(m_Ring.SQEMappingSize, IORING_OFF_SQES);
+  m_WakeHandle = eventfd(0, EFD_CLOEXEC);
+  if (!m_Ring.SQMapping || !m_Ring.CQMapping || !m_Ring.SQEMapping || m_WakeHandle < 0) {
+    CloseRing();
+    return false;
+  }
+
+  auto *sq = static_cast<std::byte *>(m_Ring.SQMapping);
+  auto *cq = static_cast<std::byte *>(m_Ring.CQMapping);
+  m_Ring.Entries = params.sq_entries;
+  m_Ring.CQEntries = params.cq_entries;
+  m_Ring.SQHead = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+  m_Ring.SQTail = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+  m_Ring.SQMask = reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+  m_Ring.SQArray = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+  m_Ring.CQHead = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+  m_Ring.CQTail = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+  m_Ring.CQMask = reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+  m_Ring.CQEs = cq + params.cq_off.cqes;
+
+  // Registration can fail on a low RLIMIT_MEMLOCK, reads then simply use the unregistered path
+  if (!createInfo.RegisteredBuffers.empty()) {
+    std::vector<iovec> buffers;
+    for (const auto &buffer : createInfo.RegisteredBuffers)
+      buffers.push_back({.iov_base = buffer.data(), .iov_len = buffer.size()});
+    if (syscall(__NR_io_uring_register, handle, IORING_REGISTER_BUFFERS, buffers.data(), static_cast<unsigned>(buffers.size())) == 0)
+      m_Registered = createInfo.RegisteredBuffers;
+  }
+
+  return true;
+#else
+  (void)createInfo;
+  return false;
+#endif
+}
+
+// =====================
+// Submission
+// =====================
+void Context::Submit(ReadOperation *operation) {
+  m_InFlight.fetch_add(1, std::memory_order_relaxed);
+
+  if (m_Backend == Backend::ThreadPool) {
+    m_Fallback->Submit([this, operation] {
+      auto *destination = operation->m_Destination.data();
+      const size_t size = std::min(operation->m_Destination.size(), MAX_READ_SIZE);
+      int64_t done = 0;
+      while (static_cast<size_t>(done) < size) {
+        const ssize_t count = pread(operation->m_Handle, destination + done, size - done, static_cast<off_t>(operation->m_Offset + done));
+        if (count < 0 && errno == EINTR)
+          continue;
+        if (count < 0) {
+          done = -errno;
+          break;
+        }
+        if (count == 0)
+          break;
+        done += count;
+      }
+      Complete(operation, done);
+    });
+    return;
+  }
+
+  {
+    std::lock_guard lock(m_Mutex);
+    m_Pending.push_back(operation);
+  }
+  Wake();
+}
+
+void Context::Complete(ReadOperation *operation, int64_t result) {
+  // The operation belongs to the coroutine frame, it may be gone as soon as the coroutine resumes
+  operation->m_Result = result;
+  const auto awaiter = operation->m_Awaiter;
+  m_InFlight.fetch_sub(1, std::memory_order_relaxed);
+  m_Jobs->Submit([awaiter] { awaiter.resume(); });
+}
+
+void Context::Wake() const noexcept {
+  const uint64_t one = 1;
+  [[maybe_unused]] auto written = write(m_WakeHandle, &one, sizeof(one));
+}
+
+int Context::RegisteredIndex(std::span<std::byte> destination) const noexcept {
+  for (uint32_t i(0); i < m_Registered.size(); ++i) {
+    const auto &buffer = m_Registered[i];
+    if (destination.data() >= buffer.data() && destination.data() + destination.size() <= buffer.data() + buffer.size())
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+// =====================
+// Completion Loop
+// =====================
+// Only this thread touches the rings, other threads hand reads over through m_Pending and the eventfd
+// A read of the eventfd stays queued (user_data 0) so io_uring_enter wakes up when a read is submitted
+void Context::RingLoop() {
+#if YORK_IO_URING
+  Profiler::SetThreadName("IO Ring");
+
+  auto *sqes = static_cast<io_uring_sqe *>(m_Ring.SQEMapping);
+  auto *cqes = static_cast<io_uring_cqe *>(m_Ring.CQEs);
+  const uint32_t sqMask = *m_Ring.SQMask;
+  const uint32_t cqMask = *m_Ring.CQMask;
+
+  uint32_t ringInFlight = 0;
+  bool wakeArmed = false;
+
+  while (true) {
+    uint32_t tail = *m_Ring.SQTail;
+    const uint32_t head = std::atomic_ref(*m_Ring.SQHead).load(std::memory_order_acquire);
+
+    auto push = [&]() -> io_uring_sqe * {
+      const uint32_t index = tail & sqMask;
+      m_Ring.SQArray[index] = index;
+      tail++;
+      auto *sqe = &sqes[index];
+      std::memset(sqe, 0, sizeof(*sqe));
+      return sqe;
+    };
+
+    if (!wakeArmed && tail - head < m_Ring.Entries) {
+      auto *sqe = push();
+      sqe->opcode = IORING_OP_READ;
+      sqe->fd = m_WakeHandle;
+      sqe->addr = reinterpret_cast<uint64_t>(&m_WakeValue);
+      sqe->len = sizeof(m_WakeValue);
+      sqe->user_data = 0;
+      wakeArmed = true;
+    }
+
+    bool stop;
+    {
+      // One completion slot stays free for the eventfd read
+      std::lock_guard lock(m_Mutex);
+      while (!m_Pending.empty() && tail - head < m_Ring.Entries && ringInFlight + 1 < m_Ring.CQEntries) {
+        ReadOperation *operation = m_Pending.front();
+        m_Pending.pop_front();
+
+        const int fixed = RegisteredIndex(operation->m_Destination);
+        auto *sqe = push();
+        sqe->opcode = fixed >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        sqe->fd = operation->m_Handle;
+        sqe->off = operation->m_Offset;
+        sqe->addr = reinterpret_cast<uint64_t>(operation->m_Destination.data());
+        sqe->len = static_cast<uint32_t>(std::min(operation->m_Destination.size(), MAX_READ_SIZE));
+        sqe->buf_index = static_cast<uint16_t>(std::max(fixed, 0));
+        sqe->user_data = reinterpret_cast<uint64_t>(operation);
+        ringInFlight++;
+      }
+      stop = m_Stop && m_Pending.empty();
+    }
+
+    if (stop && ringInFlight == 0)
+      break;
+
+    std::atomic_ref(*m_Ring.SQTail).store(tail, std::memory_order_release);
+    // EINTR / EBUSY are retried on the next pass, completions already posted are reaped below either way
+    syscall(__NR_io_uring_enter, m_Ring.Handle, tail - head, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+    uint32_t cqHead = *m_Ring.CQHead;
+    const uint32_t cqTail = std::atomic_ref(*m_Ring.CQTail).load(std::memory_order_acquire);
+    for (; cqHead != cqTail; ++cqHead) {
+      const auto &cqe = cqes[cqHead & cqMask];
+      if (cqe.user_data == 0) {
+        wakeArmed = false;
+        continue;
+      }
+
+      ringInFlight--;
+      Complete(reinterpret_cast<ReadOperation *>(cqe.user_data), cqe.res);
+    }
+    std::atomic_ref(*m_Ring.CQHead).store(cqHead, std::memory_order_release);
+  }
+#endif
+}
+
+// =====================
+// Whole File Reads
+// =====================
+Task<Result<std::vector<std::byte>>> ReadFile(Context &context, std::string path) {
+  auto file = File::Open(path);
+  if (!file)
+    co_return YK_RESULT_FAILURE(file.error());
+
+  std::vector<std::byte> data((*file)->GetSize());
+  size_t done = 0;
+  while (done < data.size()) {
+    auto read = co_await context.Read(**file, done, std::span(data).subspan(done));
+    if (!read)
+      co_return YK_RESULT_FAILURE(read.error());
+    // The file shrank since it was opened
+    if (*read == 0) {
+      data.resize(done);
+      break;
+    }
+    done += *read;
+  }
+
+  co_return YK_RESULT_SUCCESS(std::move(data));
+}
+
+// =====================
+// Destructor
+// =====================
+void Context::CloseRing() noexcept {
+  if (m_Ring.SQEMapping)
+    munmap(m_Ring.SQEMapping, m_Ring.SQEMappingSize);
+  if (m_Ring.CQMapping && m_Ring.CQMapping != m_Ring.SQMapping)
+    munmap(m_Ring.CQMapping, m_Ring.CQMappingSize);
+  if (m_Ring.SQMapping)
+    munmap(m_Ring.SQMapping, m_Ring.SQMappingSize);
+  if (m_Ring.Handle >= 0)
+    close(m_Ring.Handle);
+  if (m_WakeHandle >= 0)
+    close(m_WakeHandle);
+
+  m_Ring = {};
+  m_WakeHandle = -1;
+  m_Registered.clear();
+}
+
+// Pending reads are finished first, their continuations are queued on the JobSystem
+Context::~Context() {
+  if (m_RingThread.joinable()) {
+    {
+      std::lock_guard lock(m_Mutex);
+      m_Stop = true;
+    }
+    Wake();
+    m_RingThread.join();
+  }
+
+  m_Fallback.reset();
+  CloseRing();
+}
+} // namespace york::io
@@ -0,0 +1,158 @@
+#pragma once
+
+/*
+ * Asynchronous File Reads (io_uring with a thread pool fallback)
+ */
+
+#include "York/Core/result.hpp"
+#include "York/Core/task.hpp"
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace york::io {
+
+// Read-only file handle
+class File {
+public:
+  static Result<std::unique_ptr<File>> Open(const std::string &path);
+
+public:
+  int GetHandle() const noexcept { return m_Handle; }
+  uint64_t GetSize() const noexcept { return m_Size; }
+
+private:
+  File() = default;
+
+public:
+  ~File();
+  File(const File &) = delete;
+  File &operator=(const File &) = delete;
+
+private:
+  int m_Handle = -1;
+  uint64_t m_Size = 0;
+};
+
+enum class Backend { IOUring, ThreadPool };
+
+// Jobs runs the coroutines once their read completed, so decoding overlaps with the reads still in flight
+// RegisteredBuffers are pinned once with the kernel (e.g. the mapped memory of a staging upload buffer),
+// reads landing inside one skip the per-read page pinning of io_uring, which is what makes them zero copy
+// The thread pool backend (FallbackThreads blocking preads) is used when io_uring is unavailable or ForceThreadPool is set
+struct ContextCreateInfo {
+  JobSystem *Jobs = nullptr;
+  uint32_t QueueDepth = 256;
+  std::vector<std::span<std::byte>> RegisteredBuffers;
+  uint32_t FallbackThreads = 2;
+  bool ForceThreadPool = false;
+};
+
+class Context;
+
+// Awaitable of Context::Read, resumes with the number of bytes read (0 at end of file)
+// It lives in the awaiting coroutine frame, the backends complete it through its address
+class ReadOperation {
+public:
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  Result<size_t> await_resume() const;
+
+private:
+  friend class Context;
+  ReadOperation(Context &context, const File &file, uint64_t offset, std::span<std::byte> destination) noexcept
+      : m_Context(context), m_Handle(file.GetHandle()), m_Offset(offset), m_Destination(destination) {}
+
+  Context &m_Context;
+  int m_Handle = -1;
+  uint64_t m_Offset = 0;
+  std::span<std::byte> m_Destination;
+  int64_t m_Result = 0;
+  std::coroutine_handle<> m_Awaiter;
+};
+
+// Usage (inside a Task): auto read = co_await io->Read(*file, 0, buffer); if (!read) co_return ...;
+// Reads may be issued from any thread, completions are reaped by one I/O thread and resumed on Jobs
+// Every awaited read must complete before the Context is destroyed
+class Context {
+public:
+  static Result<std::unique_ptr<Context>> Create(const ContextCreateInfo &createInfo);
+
+public:
+  // destination must stay valid until the read completed
+  // Like read(2) fewer bytes may be read, a single read never transfers more than 1 GiB
+  ReadOperation Read(const File &file, uint64_t offset, std::span<std::byte> destination) noexcept {
+    return ReadOperation(*this, file, offset, destination);
+  }
+
+  Backend GetBackend() const noexcept { return m_Backend; }
+  uint32_t GetInFlight() const noexcept { return m_InFlight.load(std::memory_order_relaxed); }
+
+private:
+  friend class ReadOperation;
+
+  Context() = default;
+
+  bool SetupRing(const ContextCreateInfo &createInfo);
+  void CloseRing() noexcept;
+  void Wake() const noexcept;
+  void Submit(ReadOperation *operation);
+  void Complete(ReadOperation *operation, int64_t result);
+  void RingLoop();
+  int RegisteredIndex(std::span<std::byte> destination) const noexcept;
+
+public:
+  ~Context();
+  Context(const Context &) = delete;
+  Context &operator=(const Context &) = delete;
+
+private:
+  // Mappings of the io_uring submission and completion queues
+  struct Ring {
+    int Handle = -1;
+    void *SQMapping = nullptr;
+    size_t SQMappingSize = 0;
+    void *CQMapping = nullptr;
+    size_t CQMappingSize = 0;
+    void *SQEMapping = nullptr;
+    size_t SQEMappingSize = 0;
+    uint32_t Entries = 0;
+    uint32_t CQEntries = 0;
+    uint32_t *SQHead = nullptr;
+    uint32_t *SQTail = nullptr;
+    uint32_t *SQMask = nullptr;
+    uint32_t *SQArray = nullptr;
+    uint32_t *CQHead = nullptr;
+    uint32_t *CQTail = nullptr;
+    uint32_t *CQMask = nullptr;
+    void *CQEs = nullptr;
+  };
+
+private:
+  JobSystem *m_Jobs = nullptr;
+  Backend m_Backend = Backend::ThreadPool;
+  std::atomic<uint32_t> m_InFlight = 0;
+
+  Ring m_Ring;
+  std::vector<std::span<std::byte>> m_Registered;
+  int m_WakeHandle = -1;
+  uint64_t m_WakeValue = 0;
+  std::thread m_RingThread;
+  std::mutex m_Mutex;
+  std::deque<ReadOperation *> m_Pending;
+  bool m_Stop = false;
+
+  std::unique_ptr<JobSystem> m_Fallback;
+};
+
+// Reads a whole file, e.g. a glTF buffer or a cooked asset
+Task<Result<std::vector<std::byte>>> ReadFile(Context &context, std::string path);
+} // namespace york::io
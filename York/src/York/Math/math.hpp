@@ -0,0 +1,187 @@
+#pragma once
+
+/*
+ * Minimal Vector / Quaternion / Matrix Types
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace york {
+
+struct Vec3 {
+  float X = 0.0f;
+  float Y = 0.0f;
+  float Z = 0.0f;
+
+  Vec3 operator+(const Vec3 &o) const noexcept { return {X + o.X, Y + o.Y, Z + o.Z}; }
+  Vec3 operator-(const Vec3 &o) const noexcept { return {X - o.X, Y - o.Y, Z - o.Z}; }
+  Vec3 operator*(float s) const noexcept { return {X * s, Y * s, Z * s}; }
+  bool operator==(const Vec3 &) const = default;
+};
+
+inline float Dot(const Vec3 &a, const Vec3 &b) noexcept { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+inline Vec3 Cross(const Vec3 &a, const Vec3 &b) noexcept {
+  return {a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X};
+}
+inline float Length(const Vec3 &v) noexcept { return std::sqrt(Dot(v, v)); }
+// Zero vectors stay zero
+inline Vec3 Normalize(const Vec3 &v) noexcept {
+  const float length = Length(v);
+  return length > 0.0f ? v * (1.0f / length) : Vec3{};
+}
+
+// Unit quaternion, glTF order (x, y, z, w)
+struct Quat {
+  float X = 0.0f;
+  float Y = 0.0f;
+  float Z = 0.0f;
+  float W = 1.0f;
+
+  bool operator==(const Quat &) const = default;
+};
+
+inline Quat operator*(const Quat &a, const Quat &b) noexcept {
+  return {
+      a.W * b.X + a.X * b.W + a.Y * b.Z - a.Z * b.Y,
+      a.W * b.Y - a.X * b.Z + a.Y * b.W + a.Z * b.X,
+      a.W * b.Z + a.X * b.Y - a.Y * b.X + a.Z * b.W,
+      a.W * b.W - a.X * b.X - a.Y * b.Y - a.Z * b.Z,
+  };
+}
+
+inline Quat Conjugate(const Quat &q) noexcept { return {-q.X, -q.Y, -q.Z, q.W}; }
+
+inline Quat Normalize(const Quat &q) noexcept {
+  const float length = std::sqrt(q.X * q.X + q.Y * q.Y + q.Z * q.Z + q.W * q.W);
+  if (length <= 0.0f)
+    return {};
+  const float inverse = 1.0f / length;
+  return {q.X * inverse, q.Y * inverse, q.Z * inverse, q.W * inverse};
+}
+
+// Shortest rotation taking unit vector from onto unit vector to
+inline Quat FromTo(const Vec3 &from, const Vec3 &to) noexcept {
+  const float d = Dot(from, to);
+  if (d < -0.999999f) {
+    // Opposite vectors, rotate half a turn around any perpendicular axis
+    Vec3 axis = Cross({1.0f, 0.0f, 0.0f}, from);
+    if (Dot(axis, axis) < 1e-6f)
+      axis = Cross({0.0f, 1.0f, 0.0f}, from);
+    axis = Normalize(axis);
+    return {axis.X, axis.Y, axis.Z, 0.0f};
+  }
+  const Vec3 c = Cross(from, to);
+  return Normalize(Quat{c.X, c.Y, c.Z, 1.0f + d});
+}
+
+inline Vec3 Rotate(const Quat &q, const Vec3 &v) noexcept {
+  const Vec3 u{q.X, q.Y, q.Z};
+  const Vec3 t = Cross(u, v) * 2.0f;
+  return v + t * q.W + Cross(u, t);
+}
+
+// Column-major like GLSL and glTF, M[column * 4 + row]
+struct alignas(16) Mat4 {
+  float M[16]{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+
+  float &operator()(size_t row, size_t column) noexcept { return M[column * 4 + row]; }
+  float operator()(size_t row, size_t column) const noexcept { return M[column * 4 + row]; }
+};
+
+inline Mat4 operator*(const Mat4 &a, const Mat4 &b) noexcept {
+  Mat4 r;
+  for (size_t c(0); c < 4; ++c) {
+    const float b0 = b.M[c * 4 + 0], b1 = b.M[c * 4 + 1], b2 = b.M[c * 4 + 2], b3 = b.M[c * 4 + 3];
+    for (size_t row(0); row < 4; ++row)
+      r.M[c * 4 + row] = a.M[row] * b0 + a.M[4 + row] * b1 + a.M[8 + row] * b2 + a.M[12 + row] * b3;
+  }
+  return r;
+}
+
+inline Vec3 TransformPoint(const Mat4 &m, const Vec3 &p) noexcept {
+  return {
+      m.M[0] * p.X + m.M[4] * p.Y + m.M[8] * p.Z + m.M[12],
+      m.M[1] * p.X + m.M[5] * p.Y + m.M[9] * p.Z + m.M[13],
+      m.M[2] * p.X + m.M[6] * p.Y + m.M[10] * p.Z + m.M[14],
+  };
+}
+
+// T * R * S, the glTF node transform
+inline Mat4 Compose(const Vec3 &t, const Quat &q, const Vec3 &s) noexcept {
+  const float xx = q.X * q.X, yy = q.Y * q.Y, zz = q.Z * q.Z;
+  const float xy = q.X * q.Y, xz = q.X * q.Z, yz = q.Y * q.Z;
+  const float wx = q.W * q.X, wy = q.W * q.Y, wz = q.W * q.Z;
+
+  Mat4 r;
+  r.M[0] = (1.0f - 2.0f * (yy + zz)) * s.X;
+  r.M[1] = 2.0f * (xy + wz) * s.X;
+  r.M[2] = 2.0f * (xz - wy) * s.X;
+  r.M[3] = 0.0f;
+  r.M[4] = 2.0f * (xy - wz) * s.Y;
+  r.M[5] = (1.0f - 2.0f * (xx + zz)) * s.Y;
+  r.M[6] = 2.0f * (yz + wx) * s.Y;
+  r.M[7] = 0.0f;
+  r.M[8] = 2.0f * (xz + wy) * s.Z;
+  r.M[9] = 2.0f * (yz - wx) * s.Z;
+  r.M[10] = (1.0f - 2.0f * (xx + yy)) * s.Z;
+  r.M[11] = 0.0f;
+  r.M[12] = t.X;
+  r.M[13] = t.Y;
+  r.M[14] = t.Z;
+  r.M[15] = 1.0f;
+  return r;
+}
+
+inline Vec3 GetTranslation(const Mat4 &m) noexcept { return {m.M[12], m.M[13], m.M[14]}; }
+
+// Rotation part of an affine matrix, scale is divided out of the columns (shear is not supported)
+inline Quat GetRotation(const Mat4 &m) noexcept {
+  const Vec3 x = Normalize(Vec3{m.M[0], m.M[1], m.M[2]});
+  const Vec3 y = Normalize(Vec3{m.M[4], m.M[5], m.M[6]});
+  const Vec3 z = Normalize(Vec3{m.M[8], m.M[9], m.M[10]});
+
+  const float trace = x.X + y.Y + z.Z;
+  Quat q;
+  if (trace > 0.0f) {
+    const float s = std::sqrt(trace + 1.0f) * 2.0f;
+    q = {(y.Z - z.Y) / s, (z.X - x.Z) / s, (x.Y - y.X) / s, 0.25f * s};
+  } else if (x.X > y.Y && x.X > z.Z) {
+    const float s = std::sqrt(1.0f + x.X - y.Y - z.Z) * 2.0f;
+    q = {0.25f * s, (y.X + x.Y) / s, (z.X + x.Z) / s, (y.Z - z.Y) / s};
+  } else if (y.Y > z.Z) {
+    const float s = std::sqrt(1.0f + y.Y - x.X - z.Z) * 2.0f;
+    q = {(y.X + x.Y) / s, 0.25f * s, (z.Y + y.Z) / s, (z.X - x.Z) / s};
+  } else {
+    const float s = std::sqrt(1.0f + z.Z - x.X - y.Y) * 2.0f;
+    q = {(z.X + x.Z) / s, (z.Y + y.Z) / s, 0.25f * s, (x.Y - y.X) / s};
+  }
+  return Normalize(q);
+}
+
+inline Vec3 Min(const Vec3 &a, const Vec3 &b) noexcept { return {std::min(a.X, b.X), std::min(a.Y, b.Y), std::min(a.Z, b.Z)}; }
+inline Vec3 Max(const Vec3 &a, const Vec3 &b) noexcept { return {std::max(a.X, b.X), std::max(a.Y, b.Y), std::max(a.Z, b.Z)}; }
+
+struct AABB {
+  Vec3 Min{};
+  Vec3 Max{};
+
+  Vec3 Center() const noexcept { return (Min + Max) * 0.5f; }
+  Vec3 Extent() const noexcept { return (Max - Min) * 0.5f; }
+};
+
+inline AABB Union(const AABB &a, const AABB &b) noexcept { return {Min(a.Min, b.Min), Max(a.Max, b.Max)}; }
+
+// Bounds of a transformed box, from the absolute value of the rotation/scale part
+inline AABB TransformAABB(const Mat4 &m, const AABB &box) noexcept {
+  const Vec3 c = TransformPoint(m, box.Center());
+  const Vec3 e = box.Extent();
+  const Vec3 r{
+      std::abs(m.M[0]) * e.X + std::abs(m.M[4]) * e.Y + std::abs(m.M[8]) * e.Z,
+      std::abs(m.M[1]) * e.X + std::abs(m.M[5]) * e.Y + std::abs(m.M[9]) * e.Z,
+      std::abs(m.M[2]) * e.X + std::abs(m.M[6]) * e.Y + std::abs(m.M[10]) * e.Z,
+  };
+  return {c - r, c + r};
+}
+} // namespace york
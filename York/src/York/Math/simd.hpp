@@ -0,0 +1,18 @@
+#pragma once
+
+/*
+ * SIMD Instruction Set Selection
+ */
+
+// SSE is baseline on x86-64, AVX2 needs the CMake option YORK_AVX2
+// Code using these keeps a scalar path for every other target
+#if defined(__SSE2__) || defined(_M_X64)
+#define YORK_SIMD_SSE
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+#define YORK_SIMD_AVX2
+#endif
+
+#if defined(YORK_SIMD_SSE) || defined(YORK_SIMD_AVX2)
+#include <immintrin.h>
+#endif
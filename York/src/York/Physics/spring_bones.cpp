@@ -0,0 +1,472 @@
+#include "York/Physics/spring_bones.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/job_system.hpp"
+#include "York/Core/profiler.hpp"
+#include "York/Math/simd.hpp"
+#include "York/Scene/transform_hierarchy.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+
+namespace york {
+
+// Closest point to p on the capsule segment
+static Vec3 ClosestPoint(const Vec3 &start, const Vec3 &segment, float inverseLength2, const Vec3 &p) noexcept {
+  const float t = std::clamp(Dot(p - start, segment) * inverseLength2, 0.0f, 1.0f);
+  return start + segment * t;
+}
+
+// =====================
+// Lanes
+// =====================
+// One float per chain of a batch, masks are 4 bit lane sets
+#if defined(YORK_SIMD_SSE)
+struct Float4 {
+  __m128 V;
+};
+
+static Float4 Load4(const float *p) noexcept { return {_mm_loadu_ps(p)}; }
+static void Store4(float *p, Float4 a) noexcept { _mm_storeu_ps(p, a.V); }
+static Float4 Splat4(float s) noexcept { return {_mm_set1_ps(s)}; }
+static Float4 operator+(Float4 a, Float4 b) noexcept { return {_mm_add_ps(a.V, b.V)}; }
+static Float4 operator-(Float4 a, Float4 b) noexcept { return {_mm_sub_ps(a.V, b.V)}; }
+static Float4 operator*(Float4 a, Float4 b) noexcept { return {_mm_mul_ps(a.V, b.V)}; }
+static Float4 operator/(Float4 a, Float4 b) noexcept { return {_mm_div_ps(a.V, b.V)}; }
+static Float4 Sqrt4(Float4 a) noexcept { return {_mm_sqrt_ps(a.V)}; }
+static Float4 Clamp4(Float4 a, float low, float high) noexcept { return {_mm_min_ps(_mm_max_ps(a.V, _mm_set1_ps(low)), _mm_set1_ps(high))}; }
+static uint32_t Less4(Float4 a, Float4 b) noexcept { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(a.V, b.V))); }
+
+static Float4 Select4(uint32_t mask, Float4 a, Float4 b) noexcept {
+  const __m128i lanes = _mm_setr_epi32(1, 2, 4, 8);
+  const __m128 m = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(mask)), lanes), lanes));
+  return {_mm_or_ps(_mm_and_ps(m, a.V), _mm_andnot_ps(m, b.V))};
+}
+#else
+struct Float4 {
+  float V[4];
+};
+
+template <typename F> static Float4 Map4(F &&f) noexcept {
+  Float4 r;
+  for (uint32_t l(0); l < 4; ++l)
+    r.V[l] = f(l);
+  return r;
+}
+
+static Float4 Load4(const float *p) noexcept { return {p[0], p[1], p[2], p[3]}; }
+static void Store4(float *p, Float4 a) noexcept { std::copy_n(a.V, 4, p); }
+static Float4 Splat4(float s) noexcept { return {s, s, s, s}; }
+static Float4 operator+(Float4 a, Float4 b) noexcept { return Map4([&](uint32_t l) { return a.V[l] + b.V[l]; }); }
+static Float4 operator-(Float4 a, Float4 b) noexcept { return Map4([&](uint32_t l) { return a.V[l] - b.V[l]; }); }
+static Float4 operator*(Float4 a, Float4 b) noexcept { return Map4([&](uint32_t l) { return a.V[l] * b.V[l]; }); }
+static Float4 operator/(Float4 a, Float4 b) noexcept { return Map4([&](uint32_t l) { return a.V[l] / b.V[l]; }); }
+static Float4 Sqrt4(Float4 a) noexcept { return Map4([&](uint32_t l) { return std::sqrt(a.V[l]); }); }
+static Float4 Clamp4(Float4 a, float low, float high) noexcept { return Map4([&](uint32_t l) { return std::clamp(a.V[l], low, high); }); }
+static Float4 Select4(uint32_t mask, Float4 a, Float4 b) noexcept { return Map4([&](uint32_t l) { return mask >> l & 1 ? a.V[l] : b.V[l]; }); }
+
+static uint32_t Less4(Float4 a, Float4 b) noexcept {
+  uint32_t mask = 0;
+  for (uint32_t l(0); l < 4; ++l)
+    mask |= a.V[l] < b.V[l] ? 1U << l : 0U;
+  return mask;
+}
+#endif
+
+struct Vec3x4 {
+  Float4 X, Y, Z;
+};
+
+struct Quatx4 {
+  Float4 X, Y, Z, W;
+};
+
+static Vec3x4 Splat4(const Vec3 &v) noexcept { return {Splat4(v.X), Splat4(v.Y), Splat4(v.Z)}; }
+static Vec3x4 operator+(const Vec3x4 &a, const Vec3x4 &b) noexcept { return {a.X + b.X, a.Y + b.Y, a.Z + b.Z}; }
+static Vec3x4 operator-(const Vec3x4 &a, const Vec3x4 &b) noexcept { return {a.X - b.X, a.Y - b.Y, a.Z - b.Z}; }
+static Vec3x4 operator*(const Vec3x4 &a, Float4 s) noexcept { return {a.X * s, a.Y * s, a.Z * s}; }
+static Float4 Dot(const Vec3x4 &a, const Vec3x4 &b) noexcept { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+static Vec3x4 Cross(const Vec3x4 &a, const Vec3x4 &b) noexcept {
+  return {a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X};
+}
+static Vec3x4 Select4(uint32_t mask, const Vec3x4 &a, const Vec3x4 &b) noexcept {
+  return {Select4(mask, a.X, b.X), Select4(mask, a.Y, b.Y), Select4(mask, a.Z, b.Z)};
+}
+
+// 1 / a, zero where a is not positive
+static Float4 SafeInverse4(Float4 a) noexcept { return Select4(Less4(Splat4(0.0f), a), Splat4(1.0f) / a, Splat4(0.0f)); }
+
+// Zero vectors stay zero
+static Vec3x4 Normalize(const Vec3x4 &v) noexcept { return v * SafeInverse4(Sqrt4(Dot(v, v))); }
+
+static Quatx4 operator*(const Quatx4 &a, const Quatx4 &b) noexcept {
+  return {
+      a.W * b.X + a.X * b.W + a.Y * b.Z - a.Z * b.Y,
+      a.W * b.Y - a.X * b.Z + a.Y * b.W + a.Z * b.X,
+      a.W * b.Z + a.X * b.Y - a.Y * b.X + a.Z * b.W,
+      a.W * b.W - a.X * b.X - a.Y * b.Y - a.Z * b.Z,
+  };
+}
+
+static Quatx4 Conjugate(const Quatx4 &q) noexcept {
+  const Float4 zero = Splat4(0.0f);
+  return {zero - q.X, zero - q.Y, zero - q.Z, q.W};
+}
+
+static Vec3x4 Rotate(const Quatx4 &q, const Vec3x4 &v) noexcept {
+  const Vec3x4 u{q.X, q.Y, q.Z};
+  const Vec3x4 t = Cross(u, v) * Splat4(2.0f);
+  return v + t * q.W + Cross(u, t);
+}
+
+// Same as FromTo in math.hpp, opposite vectors are rare and take the scalar path
+static Quatx4 FromTo(const Vec3x4 &from, const Vec3x4 &to) noexcept {
+  const Float4 d = Dot(from, to);
+  const Vec3x4 c = Cross(from, to);
+  const Float4 w = Splat4(1.0f) + d;
+  const Float4 inverse = Splat4(1.0f) / Sqrt4(Dot(c, c) + w * w);
+  Quatx4 q{c.X * inverse, c.Y * inverse, c.Z * inverse, w * inverse};
+
+  if (uint32_t opposite = Less4(d, Splat4(-0.999999f))) {
+    float f[3][4], t[3][4], r[4][4];
+    Store4(f[0], from.X), Store4(f[1], from.Y), Store4(f[2], from.Z);
+    Store4(t[0], to.X), Store4(t[1], to.Y), Store4(t[2], to.Z);
+    Store4(r[0], q.X), Store4(r[1], q.Y), Store4(r[2], q.Z), Store4(r[3], q.W);
+    for (; opposite; opposite &= opposite - 1) {
+      const uint32_t l = static_cast<uint32_t>(std::countr_zero(opposite));
+      const Quat s = FromTo(Vec3{f[0][l], f[1][l], f[2][l]}, Vec3{t[0][l], t[1][l], t[2][l]});
+      r[0][l] = s.X, r[1][l] = s.Y, r[2][l] = s.Z, r[3][l] = s.W;
+    }
+    q = {Load4(r[0]), Load4(r[1]), Load4(r[2]), Load4(r[3])};
+  }
+  return q;
+}
+
+// =====================
+// Solver Creation
+// =====================
+Result<std::unique_ptr<SpringBoneSolver>> SpringBoneSolver::Create(const SpringBoneSolverCreateInfo &createInfo) {
+  if (!createInfo.Hierarchy)
+    return YK_RESULT_FAILURE(Error::Create("SpringBoneSolver needs a TransformHierarchy"));
+  if (createInfo.FixedTimestep <= 0.0)
+    return YK_RESULT_FAILURE(Error::Create(std::format("Invalid fixed timestep {}", createInfo.FixedTimestep)));
+
+  auto solver = std::unique_ptr<SpringBoneSolver>(new SpringBoneSolver());
+  solver->m_Hierarchy = createInfo.Hierarchy;
+  solver->m_Jobs = createInfo.Jobs;
+  solver->m_FixedTimestep = createInfo.FixedTimestep;
+  solver->m_MaxSubsteps = std::max(createInfo.MaxSubsteps, 1U);
+  solver->m_ParallelThreshold = createInfo.ParallelThreshold;
+
+  const auto &hierarchy = *createInfo.Hierarchy;
+  const uint32_t nodeCount = hierarchy.GetNodeCount();
+
+  for (const auto &collider : createInfo.Colliders) {
+    if (collider.Node >= nodeCount)
+      return YK_RESULT_FAILURE(Error::Create(std::format("Spring collider node {} does not exist", collider.Node)));
+  }
+
+  // Bone data per joint, chains are contiguous ranges until they are dealt into batches
+  struct ChainJoint {
+    uint32_t Node;
+    Quat Rest;
+    Vec3 Axis;
+    float Length;
+  };
+  std::vector<ChainJoint> joints;
+  std::vector<uint32_t> chainFirsts;
+  std::vector<const SpringChainCreateInfo *> chainCIs;
+
+  for (const auto &chainCI : createInfo.Chains) {
+    if (chainCI.Joints.empty())
+      continue;
+
+    chainFirsts.push_back(static_cast<uint32_t>(joints.size()));
+    chainCIs.push_back(&chainCI);
+    for (size_t k(0); k < chainCI.Joints.size(); ++k) {
+      const uint32_t node = chainCI.Joints[k];
+      if (node >= nodeCount)
+        return YK_RESULT_FAILURE(Error::Create(std::format("Spring joint {} does not exist", node)));
+
+      // The bone points at the next joint, the last one at its tip
+      Vec3 localTail = chainCI.TipOffset;
+      if (k + 1 < chainCI.Joints.size()) {
+        const uint32_t next = chainCI.Joints[k + 1];
+        if (next >= nodeCount || hierarchy.GetParent(next) != static_cast<int32_t>(node))
+          return YK_RESULT_FAILURE(Error::Create(std::format("Spring joint {} is not a child of {}", next, node)));
+        localTail = hierarchy.GetTranslation(next);
+      }
+
+      const Mat4 &world = hierarchy.GetWorld(node);
+      joints.push_back({
+          .Node = node,
+          .Rest = hierarchy.GetRotation(node),
+          .Axis = Normalize(localTail),
+          .Length = Length(TransformPoint(world, localTail) - GetTranslation(world)),
+      });
+    }
+  }
+
+  // Chains of equal joint count share batches, a partial batch repeats its first chain in the spare lanes
+  std::vector<uint32_t> order(chainCIs.size());
+  for (uint32_t c(0); c < order.size(); ++c)
+    order[c] = c;
+  std::ranges::stable_sort(order, {}, [&](uint32_t c) { return chainCIs[c]->Joints.size(); });
+
+  for (size_t begin(0); begin < order.size();) {
+    const uint32_t jointCount = static_cast<uint32_t>(chainCIs[order[begin]]->Joints.size());
+    size_t end = begin + 1;
+    while (end < order.size() && end - begin < LANES && chainCIs[order[end]]->Joints.size() == jointCount)
+      ++end;
+
+    Batch batch{
+        .LaneCount = static_cast<uint32_t>(end - begin),
+        .JointCount = jointCount,
+        .JointFirst = static_cast<uint32_t>(solver->m_Joints.size()),
+        .ColliderFirst = static_cast<uint32_t>(solver->m_BatchColliders.size()),
+    };
+    solver->m_Joints.resize(solver->m_Joints.size() + jointCount);
+    JointBlock *blocks = &solver->m_Joints[batch.JointFirst];
+
+    for (uint32_t l(0); l < LANES; ++l) {
+      const uint32_t chain = order[begin + (l < batch.LaneCount ? l : 0)];
+      const auto &chainCI = *chainCIs[chain];
+      const Vec3 gravity = Normalize(chainCI.GravityDirection) * chainCI.GravityPower;
+      batch.Stiffness[l] = chainCI.Stiffness;
+      batch.Drag[l] = std::clamp(chainCI.Drag, 0.0f, 1.0f);
+      batch.GravityX[l] = gravity.X, batch.GravityY[l] = gravity.Y, batch.GravityZ[l] = gravity.Z;
+      batch.HitRadius[l] = chainCI.HitRadius;
+      if (l < batch.LaneCount)
+        batch.MaxHitRadius = std::max(batch.MaxHitRadius, chainCI.HitRadius);
+
+      float reach = 0.0f;
+      for (uint32_t k(0); k < jointCount; ++k) {
+        const auto &joint = joints[chainFirsts[chain] + k];
+        auto &block = blocks[k];
+        block.Nodes[l] = joint.Node;
+        block.RestX[l] = joint.Rest.X, block.RestY[l] = joint.Rest.Y, block.RestZ[l] = joint.Rest.Z, block.RestW[l] = joint.Rest.W;
+        block.ResultX[l] = joint.Rest.X, block.ResultY[l] = joint.Rest.Y, block.ResultZ[l] = joint.Rest.Z, block.ResultW[l] = joint.Rest.W;
+        block.AxisX[l] = joint.Axis.X, block.AxisY[l] = joint.Axis.Y, block.AxisZ[l] = joint.Axis.Z;
+        block.Length[l] = joint.Length;
+        reach += joint.Length;
+        if (l < batch.LaneCount)
+          block.Reach = std::max(block.Reach, reach);
+      }
+    }
+
+    // Group masks never change, colliders of other groups are dropped once here
+    for (uint32_t i(0); i < createInfo.Colliders.size(); ++i) {
+      uint32_t laneMask = 0;
+      for (uint32_t l(0); l < batch.LaneCount; ++l)
+        laneMask |= createInfo.Colliders[i].Group & chainCIs[order[begin + l]]->ColliderGroups ? 1U << l : 0U;
+      if (laneMask)
+        solver->m_BatchColliders.push_back({.Collider = i, .LaneMask = laneMask});
+    }
+    batch.ColliderCount = static_cast<uint32_t>(solver->m_BatchColliders.size()) - batch.ColliderFirst;
+
+    solver->m_JointCount += batch.LaneCount * jointCount;
+    solver->m_Batches.push_back(batch);
+    begin = end;
+  }
+
+  solver->m_ColliderInfos = createInfo.Colliders;
+  solver->m_Colliders.resize(createInfo.Colliders.size());
+  solver->m_Candidates.resize(solver->m_BatchColliders.size());
+
+  solver->Reset();
+  return YK_RESULT_SUCCESS(solver);
+}
+
+void SpringBoneSolver::Reset() {
+  for (auto &block : m_Joints) {
+    for (uint32_t l(0); l < LANES; ++l) {
+      const Mat4 &world = m_Hierarchy->GetWorld(block.Nodes[l]);
+      const Vec3 tail = GetTranslation(world) + Rotate(GetRotation(world), {block.AxisX[l], block.AxisY[l], block.AxisZ[l]}) * block.Length[l];
+      block.PrevX[l] = block.CurrentX[l] = tail.X;
+      block.PrevY[l] = block.CurrentY[l] = tail.Y;
+      block.PrevZ[l] = block.CurrentZ[l] = tail.Z;
+    }
+  }
+  m_Accumulator = 0.0;
+}
+
+// =====================
+// Colliders
+// =====================
+void SpringBoneSolver::UpdateColliders() {
+  for (uint32_t i(0); i < m_Colliders.size(); ++i) {
+    const auto &info = m_ColliderInfos[i];
+    const Mat4 &world = m_Hierarchy->GetWorld(info.Node);
+    const Vec3 head = TransformPoint(world, info.Offset);
+    const Vec3 segment = TransformPoint(world, info.Tail) - head;
+    const float length2 = Dot(segment, segment);
+
+    // Radii scale with the largest axis of the node
+    const float scale = std::max({Length({world.M[0], world.M[1], world.M[2]}), Length({world.M[4], world.M[5], world.M[6]}),
+                                  Length({world.M[8], world.M[9], world.M[10]})});
+
+    m_Colliders[i] = {
+        .Start = head,
+        .Segment = segment,
+        .InverseSegmentLength2 = length2 > 1e-12f ? 1.0f / length2 : 0.0f,
+        .Radius = info.Radius * scale,
+    };
+  }
+}
+
+// A tail stays within its joint's Reach of its root head, and the root heads within spread of their center
+// Colliders further than that are skipped for the frame, the others are sorted so each joint stops at the first out of its reach
+uint32_t SpringBoneSolver::GatherColliders(uint32_t batchIndex, const Vec3 *rootHeads) {
+  const auto &batch = m_Batches[batchIndex];
+  const float reach = m_Joints[batch.JointFirst + batch.JointCount - 1].Reach;
+
+  Vec3 center{};
+  for (uint32_t l(0); l < batch.LaneCount; ++l)
+    center = center + rootHeads[l];
+  center = center * (1.0f / static_cast<float>(batch.LaneCount));
+  float spread = 0.0f;
+  for (uint32_t l(0); l < batch.LaneCount; ++l)
+    spread = std::max(spread, Length(rootHeads[l] - center));
+
+  Candidate *candidates = &m_Candidates[batch.ColliderFirst];
+  uint32_t count = 0;
+  for (uint32_t k(0); k < batch.ColliderCount; ++k) {
+    const auto &batchCollider = m_BatchColliders[batch.ColliderFirst + k];
+    const auto &collider = m_Colliders[batchCollider.Collider];
+    const float distance = Length(center - ClosestPoint(collider.Start, collider.Segment, collider.InverseSegmentLength2, center)) -
+                           collider.Radius - batch.MaxHitRadius - spread;
+    if (distance > reach)
+      continue;
+
+    // Insertion sort, batches see a handful of colliders
+    uint32_t slot = count++;
+    for (; slot > 0 && candidates[slot - 1].Distance > distance; --slot)
+      candidates[slot] = candidates[slot - 1];
+    candidates[slot] = {.Collider = batchCollider.Collider, .LaneMask = batchCollider.LaneMask, .Distance = distance};
+  }
+  return count;
+}
+
+// =====================
+// Integration
+// =====================
+// Joints of one chain depend on each other, a lone chain leaves the core waiting on sqrt and division latency
+// The lanes are independent chains, so every instruction advances four of them
+void SpringBoneSolver::SolveBatch(uint32_t batchIndex, float dt, uint32_t steps) {
+  const auto &batch = m_Batches[batchIndex];
+  JointBlock *blocks = &m_Joints[batch.JointFirst];
+
+  // The animated pose above the chains is fixed for this frame, only the chains themselves move
+  float parent[4][LANES], head[3][LANES];
+  Vec3 rootHeads[LANES];
+  for (uint32_t l(0); l < LANES; ++l) {
+    const uint32_t rootNode = blocks[0].Nodes[l];
+    const int32_t rootParent = m_Hierarchy->GetParent(rootNode);
+    const Quat rotation = rootParent >= 0 ? GetRotation(m_Hierarchy->GetWorld(static_cast<uint32_t>(rootParent))) : Quat{};
+    rootHeads[l] = GetTranslation(m_Hierarchy->GetWorld(rootNode));
+    parent[0][l] = rotation.X, parent[1][l] = rotation.Y, parent[2][l] = rotation.Z, parent[3][l] = rotation.W;
+    head[0][l] = rootHeads[l].X, head[1][l] = rootHeads[l].Y, head[2][l] = rootHeads[l].Z;
+  }
+  const Quatx4 rootParent{Load4(parent[0]), Load4(parent[1]), Load4(parent[2]), Load4(parent[3])};
+  const Vec3x4 rootHead{Load4(head[0]), Load4(head[1]), Load4(head[2])};
+
+  const uint32_t candidateCount = GatherColliders(batchIndex, rootHeads);
+  const Candidate *candidates = &m_Candidates[batch.ColliderFirst];
+
+  const Float4 stiffness = Load4(batch.Stiffness) * Splat4(dt);
+  const Float4 keep = Splat4(1.0f) - Load4(batch.Drag);
+  const Vec3x4 gravity = Vec3x4{Load4(batch.GravityX), Load4(batch.GravityY), Load4(batch.GravityZ)} * Splat4(dt);
+  const Float4 hitRadius = Load4(batch.HitRadius);
+
+  for (uint32_t step(0); step < steps; ++step) {
+    // Only the last step's rotations are written back
+    const bool last = step + 1 == steps;
+    Quatx4 parentWorld = rootParent;
+    Vec3x4 jointHead = rootHead;
+
+    for (uint32_t k(0); k < batch.JointCount; ++k) {
+      auto &block = blocks[k];
+      const Float4 length = Load4(block.Length);
+      const Quatx4 rest = parentWorld * Quatx4{Load4(block.RestX), Load4(block.RestY), Load4(block.RestZ), Load4(block.RestW)};
+      const Vec3x4 restDirection = Rotate(rest, {Load4(block.AxisX), Load4(block.AxisY), Load4(block.AxisZ)});
+      const Vec3x4 current{Load4(block.CurrentX), Load4(block.CurrentY), Load4(block.CurrentZ)};
+      const Vec3x4 previous{Load4(block.PrevX), Load4(block.PrevY), Load4(block.PrevZ)};
+
+      // Verlet: inertia damped by drag, pulled back to the rest pose, then gravity
+      const Vec3x4 next = current + (current - previous) * keep + restDirection * stiffness + gravity;
+      Vec3x4 direction = Normalize(next - jointHead);
+      Vec3x4 tail = jointHead + direction * length;
+
+      // Pushes the tails out of every reachable collider they penetrate, then restores the bone length
+      uint32_t moved = 0;
+      for (uint32_t c(0); c < candidateCount && candidates[c].Distance <= block.Reach; ++c) {
+        const auto &collider = m_Colliders[candidates[c].Collider];
+        const Vec3x4 start = Splat4(collider.Start), segment = Splat4(collider.Segment);
+        const Float4 t = Clamp4(Dot(tail - start, segment) * Splat4(collider.InverseSegmentLength2), 0.0f, 1.0f);
+        const Vec3x4 closest = start + segment * t;
+        const Vec3x4 delta = tail - closest;
+        const Float4 distance2 = Dot(delta, delta);
+        const Float4 radius = Splat4(collider.Radius) + hitRadius;
+        const uint32_t hits = Less4(distance2, radius * radius) & candidates[c].LaneMask;
+        if (!hits)
+          continue;
+
+        const Vec3x4 pushed = closest + delta * (radius * SafeInverse4(Sqrt4(distance2)));
+        tail = Select4(hits, jointHead + Normalize(pushed - jointHead) * length, tail);
+        moved |= hits;
+      }
+      // Collisions keep the bone length, the direction only needs a rescale
+      if (moved)
+        direction = Select4(moved & Less4(Splat4(0.0f), length), (tail - jointHead) * SafeInverse4(length), direction);
+
+      Store4(block.PrevX, current.X), Store4(block.PrevY, current.Y), Store4(block.PrevZ, current.Z);
+      Store4(block.CurrentX, tail.X), Store4(block.CurrentY, tail.Y), Store4(block.CurrentZ, tail.Z);
+
+      // Rotation that turns the rest direction onto the simulated one, products of unit quaternions stay unit
+      const Quatx4 world = FromTo(restDirection, direction) * rest;
+      if (last) {
+        const Quatx4 local = Conjugate(parentWorld) * world;
+        Store4(block.ResultX, local.X), Store4(block.ResultY, local.Y), Store4(block.ResultZ, local.Z), Store4(block.ResultW, local.W);
+      }
+
+      parentWorld = world;
+      jointHead = tail;
+    }
+  }
+}
+
+void SpringBoneSolver::Update(double deltaSeconds) {
+  YK_PROFILE_FUNCTION();
+  m_Accumulator += std::max(deltaSeconds, 0.0);
+  const uint32_t available = static_cast<uint32_t>(m_Accumulator / m_FixedTimestep);
+  const uint32_t steps = std::min(available, m_MaxSubsteps);
+  // Past MaxSubsteps the simulation slows down instead of spiraling
+  m_Accumulator -= static_cast<double>(available) * m_FixedTimestep;
+
+  if (steps == 0)
+    return;
+
+  UpdateColliders();
+
+  const float dt = static_cast<float>(m_FixedTimestep);
+  const uint32_t batchCount = static_cast<uint32_t>(m_Batches.size());
+  if (m_Jobs && GetJointCount() >= m_ParallelThreshold) {
+    m_Jobs->ParallelFor(batchCount, 1, [&](uint32_t begin, uint32_t end) {
+      for (uint32_t b = begin; b < end; ++b)
+        SolveBatch(b, dt, steps);
+    });
+  } else {
+    for (uint32_t b(0); b < batchCount; ++b)
+      SolveBatch(b, dt, steps);
+  }
+
+  // TransformHierarchy setters are not thread safe, the write-back stays on the caller
+  for (const auto &batch : m_Batches) {
+    for (uint32_t k(0); k < batch.JointCount; ++k) {
+      const auto &block = m_Joints[batch.JointFirst + k];
+      for (uint32_t l(0); l < batch.LaneCount; ++l)
+        m_Hierarchy->SetRotation(block.Nodes[l], {block.ResultX[l], block.ResultY[l], block.ResultZ[l], block.ResultW[l]});
+    }
+  }
+}
+} // namespace york
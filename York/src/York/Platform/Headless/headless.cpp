@@ -0,0 +1,26 @@
+#include "York/Platform/Headless/headless.hpp"
+#include "York/Graphics/Vulkan/helpers.hpp"
+#include "York/Graphics/Vulkan/instance.hpp"
+#include <format>
+
+namespace york {
+Result<VkSurfaceKHR> PlatformTraits<Headless>::CreateSurface(const vulkan::Instance &instance, HandleType) {
+  VkSurfaceKHR result = VK_NULL_HANDLE;
+
+  const auto &vk = instance.GetDispatch();
+  if (!vk.CreateHeadlessSurfaceEXT)
+    return YK_RESULT_FAILURE(Error::Create("VK_EXT_headless_surface is not enabled on the Instance"));
+
+  const VkHeadlessSurfaceCreateInfoEXT surfaceCI{
+      .sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT,
+      .pNext = nullptr,
+      .flags = {},
+  };
+
+  if (auto code = vk.CreateHeadlessSurfaceEXT(instance.Get(), &surfaceCI, nullptr, &result); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateHeadlessSurfaceEXT failed: {}", vulkan::ToString(code))));
+
+  return result;
+}
+
+} // namespace york
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "York/Core/window.hpp"
+#include <vulkan/vulkan.h>
+
+namespace york {
+class Headless;
+
+namespace vulkan {
+class Instance;
+}
+
+// Stand-in for a native surface, there is no compositor behind it
+// Width and Height are the extent of the offscreen images, FrameIndex counts Window<Headless>::Frame calls
+struct HeadlessSurface {
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  uint64_t FrameIndex = 0;
+};
+
+// VK_EXT_headless_surface is optional: without it the renderer draws straight into vulkan::OffscreenTarget
+template <>
+struct PlatformTraits<Headless> {
+  static constexpr const char *VULKAN_EXTENSION_NAME = VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME;
+  static constexpr bool SURFACE_OPTIONAL = true;
+  using HandleType = HeadlessSurface *;
+  using LayerType = std::nullptr_t;
+  using FrameCallbackType = std::nullptr_t;
+  using ViewportType = std::nullptr_t;
+  using FractionalScaleType = std::nullptr_t;
+
+  Result<VkSurfaceKHR> CreateSurface(const vulkan::Instance &instance, HandleType handle);
+};
+} // namespace york
@@ -0,0 +1,79 @@
+#include "York/Core/window.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
+#include "York/Core/result.hpp"
+#include "York/Platform/Headless/headless.hpp"
+
+namespace york {
+template <>
+uint32_t Window<Headless>::s_WindowCount = 0;
+
+// Headless windows have no layer shell, layered create infos behave like plain windows
+template <>
+Result<> Window<Headless>::MakeLayer() {
+  return YK_RESULT_SUCCESS({});
+}
+
+template <>
+Result<> Window<Headless>::Init() {
+  if (m_CreateInfo.Width == 0 || m_CreateInfo.Height == 0)
+    return YK_RESULT_FAILURE(Error::Create("Headless window requires a non-zero extent"));
+
+  m_Handle = new HeadlessSurface{.Width = m_CreateInfo.Width, .Height = m_CreateInfo.Height};
+  m_Layer = nullptr;
+  m_State.Configured = true;
+  m_RenderExtent = {m_CreateInfo.Width, m_CreateInfo.Height};
+  m_Damage.SetExtent(m_CreateInfo.Width, m_CreateInfo.Height);
+  return YK_RESULT_SUCCESS({});
+}
+
+// Offscreen images are sized by the renderer, there is no compositor scaling step
+template <>
+bool Window<Headless>::SetRenderExtent(const Extent &extent) {
+  m_RenderExtent = extent;
+  m_Handle->Width = extent.Width;
+  m_Handle->Height = extent.Height;
+  m_Damage.SetExtent(extent.Width, extent.Height);
+  return true;
+}
+
+template <>
+Result<std::unique_ptr<Window<Headless>>> Window<Headless>::Create(const WindowCreateInfo &ci) {
+  auto window = std::unique_ptr<Window<Headless>>(new Window<Headless>);
+
+  window->m_CreateInfo = ci;
+  if (auto result = window->Init(); !result)
+    return YK_RESULT_FAILURE(result.error());
+
+  Window<Headless>::s_WindowCount++;
+  return YK_RESULT_SUCCESS(window);
+}
+
+template <>
+void Window<Headless>::Present() {
+  YK_PROFILE_FUNCTION();
+  m_Damage.Clear();
+  m_Handle->FrameIndex++;
+}
+
+// Nothing to wait on, the caller paces the loop (benchmarks run as fast as the GPU allows)
+template <>
+Result<> Window<Headless>::DispatchEvents(uint32_t) {
+  return YK_RESULT_SUCCESS({});
+}
+
+// A single virtual output, its extent follows whatever the offscreen targets are created with
+template <>
+Result<std::vector<OutputInfo>> Window<Headless>::EnumerateOutputs() {
+  return std::vector<OutputInfo>{{.ID = 0, .Name = "HEADLESS-1", .Description = "Offscreen output"}};
+}
+
+template <>
+Window<Headless>::~Window() {
+  if (m_Handle) {
+    delete m_Handle;
+    Window<Headless>::s_WindowCount--;
+  }
+}
+
+} // namespace york
@@ -1,21 +1,24 @@
 #include "York/Platform/Wayland/wayland.hpp"
+#include "York/Core/error.hpp"
 #include "York/Graphics/Vulkan/helpers.hpp"
+#include "York/Graphics/Vulkan/instance.hpp"
+#include <format>
 
 namespace york {
-Result<VkSurfaceKHR> PlatformTraits<Wayland>::CreateSurface(VkInstance instance, HandleType handle) {
-  extern WaylandState state;
+Result<VkSurfaceKHR> PlatformTraits<Wayland>::CreateSurface(const vulkan::Instance &instance, HandleType handle) {
+  extern WaylandState g_SharedState;
   VkSurfaceKHR result = nullptr;
 
   VkWaylandSurfaceCreateInfoKHR surfaceCI{
       .sType = VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR,
       .pNext = nullptr,
       .flags = {},
-      .display = state.Display,
+      .display = g_SharedState.Display,
       .surface = handle,
   };
 
-  if (auto code = vkCreateWaylandSurfaceKHR(instance, &surfaceCI, nullptr, &result); code != VK_SUCCESS)
-    return failure<VkSurfaceKHR, VkSurfaceKHR>(vulkan::ToString(code), ErrorCode::VKCreation);
+  if (auto code = instance.GetDispatch().CreateWaylandSurfaceKHR(instance.Get(), &surfaceCI, nullptr, &result); code != VK_SUCCESS)
+    return YK_RESULT_FAILURE(Error::Create(std::format("vkCreateWaylandSurfaceKHR failed: {}", vulkan::ToString(code))));
 
   return result;
 }
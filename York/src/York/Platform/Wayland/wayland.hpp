@@ -1,10 +1,15 @@
 #pragma once
 
 #include "York/Core/window.hpp"
+#include <memory>
+#include <string>
+#include <vector>
 extern "C" {
 #include <wayland-client.h>
 #include <xdg-shell-client-protocol.h>
 #include <zwlr-layer-shell-unstable-v1-client-protocol.h>
+#include <viewporter-client-protocol.h>
+#include <fractional-scale-v1-client-protocol.h>
 }
 #define VK_USE_PLATFORM_WAYLAND_KHR
 #include <vulkan/vulkan.h>
@@ -12,21 +17,48 @@ extern "C" {
 namespace york {
 class Wayland;
 
+namespace vulkan {
+class Instance;
+}
+
+// RegistryName is the wl_registry global name, exposed as OutputInfo::ID
+struct WaylandOutput {
+  wl_output *Handle = nullptr;
+  uint32_t Version = 0;
+  uint32_t RegistryName = 0;
+  std::string Name;
+  std::string Description;
+  int32_t Width = 0;
+  int32_t Height = 0;
+  int32_t RefreshMilliHz = 0;
+  int32_t Scale = 1;
+  bool Done = false;
+};
+
 struct WaylandState {
-  wl_display *Display;
+  wl_display *Display = nullptr;
   wl_registry *Registery = nullptr;
   wl_compositor *Compositor = nullptr;
-  wl_output *Output = nullptr;
+  uint32_t CompositorVersion = 0;
+  std::vector<std::unique_ptr<WaylandOutput>> Outputs;
   xdg_wm_base *XDG = nullptr;
   zwlr_layer_shell_v1 *ZWLR = nullptr;
+  wp_viewporter *Viewporter = nullptr;
+  wp_fractional_scale_manager_v1 *FractionalScale = nullptr;
+  // Frame callbacks requested and not done yet, over every window
+  uint32_t PendingFrames = 0;
 };
 
 template <>
 struct PlatformTraits<Wayland> {
   static constexpr const char *VULKAN_EXTENSION_NAME = VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME;
+  static constexpr bool SURFACE_OPTIONAL = false;
   using HandleType = wl_surface *;
   using LayerType = zwlr_layer_surface_v1 *;
+  using FrameCallbackType = wl_callback *;
+  using ViewportType = wp_viewport *;
+  using FractionalScaleType = wp_fractional_scale_v1 *;
 
-  Result<VkSurfaceKHR> CreateSurface(VkInstance instance, HandleType handle);
+  Result<VkSurfaceKHR> CreateSurface(const vulkan::Instance &instance, HandleType handle);
 };
 } // namespace york
\ No newline at end of file
@@ -1,9 +1,16 @@
 #include "York/Core/window.hpp"
 #include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
 #include "York/Core/result.hpp"
 #include "York/Platform/Wayland/wayland.hpp"
 #include <wayland-client-core.h>
 #include <wayland-client-protocol.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <poll.h>
 
 namespace york {
 template <>
@@ -12,29 +19,111 @@ uint32_t Window<Wayland>::s_WindowCount = 0;
 WaylandState g_SharedState;
 
 static void RegisteryAdd(void *data, struct wl_registry *, uint32_t name, const char *interface, uint32_t version);
-static constexpr wl_registry_listener REGESTRY_LISTENER{RegisteryAdd};
+static void RegisteryRemove(void *data, struct wl_registry *, uint32_t name);
+static constexpr wl_registry_listener REGESTRY_LISTENER{RegisteryAdd, RegisteryRemove};
+
+// clang-format off
+static void OutputGeometry(void *, wl_output *, int32_t, int32_t, int32_t, int32_t, int32_t, const char *, const char *, int32_t) {}
+static void OutputMode(void *data, wl_output *output, uint32_t flags, int32_t width, int32_t height, int32_t refresh);
+static void OutputDone(void *data, wl_output *output);
+static void OutputScale(void *data, wl_output *output, int32_t factor);
+static void OutputName(void *data, wl_output *output, const char *name);
+static void OutputDescription(void *data, wl_output *output, const char *description);
+static constexpr wl_output_listener OUTPUT_LISTENER{OutputGeometry, OutputMode, OutputDone, OutputScale, OutputName, OutputDescription};
+// clang-format on
 
 static void XDGPing(void *data, xdg_wm_base *wm_base, uint32_t serial) { xdg_wm_base_pong(wm_base, serial); }
 static constexpr xdg_wm_base_listener XDG_LISTENER{XDGPing};
 
 static void ZWLRConfigure(void *data, zwlr_layer_surface_v1 *surface, uint32_t serial, uint32_t width, uint32_t height);
-static constexpr zwlr_layer_surface_v1_listener ZWLR_LISTENER{ZWLRConfigure};
+static void ZWLRClosed(void *data, zwlr_layer_surface_v1 *surface);
+static constexpr zwlr_layer_surface_v1_listener ZWLR_LISTENER{ZWLRConfigure, ZWLRClosed};
+
+static void FrameDone(void *data, wl_callback *callback, uint32_t time);
+static constexpr wl_callback_listener FRAME_LISTENER{FrameDone};
+
+static void PreferredScale(void *data, wp_fractional_scale_v1 *fractionalScale, uint32_t scale);
+static constexpr wp_fractional_scale_v1_listener FRACTIONAL_SCALE_LISTENER{PreferredScale};
+
+static Result<> WaitForEvents(int timeoutMs);
+
+// wl_output.release (v3) also frees the compositor side of the binding
+static void ReleaseOutput(const WaylandOutput &output) {
+  if (output.Version >= WL_OUTPUT_RELEASE_SINCE_VERSION)
+    wl_output_release(output.Handle);
+  else
+    wl_output_destroy(output.Handle);
+}
+
+static void DisconnectDisplay() {
+  for (const auto &output : g_SharedState.Outputs)
+    ReleaseOutput(*output);
+  wl_display_disconnect(g_SharedState.Display);
+  g_SharedState = {};
+}
+
+// The connection is unusable after a protocol error or a hang-up, wl_display_get_error holds the errno
+static Error DisplayError(wl_display *display) {
+  return Error::Create(std::format("Wayland connection lost: {}", std::strerror(wl_display_get_error(display))));
+}
+
+static Result<> ConnectDisplay() {
+  if (g_SharedState.Display)
+    return YK_RESULT_SUCCESS({});
+
+  if (g_SharedState.Display = wl_display_connect(nullptr); !g_SharedState.Display)
+    return YK_RESULT_FAILURE(Error::Create("wl_display_connect failed"));
+
+  if (g_SharedState.Registery = wl_display_get_registry(g_SharedState.Display); !g_SharedState.Registery) {
+    DisconnectDisplay();
+    return YK_RESULT_FAILURE(Error::Create("wl_display_get_registry failed"));
+  }
+
+  wl_registry_add_listener(g_SharedState.Registery, &REGESTRY_LISTENER, nullptr);
+
+  // One roundtrip announces every global present at connection time
+  // There may be no output yet (lid closed, monitors unplugged, headless compositor), outputs are bound as they appear
+  if (wl_display_roundtrip(g_SharedState.Display) < 0) {
+    auto error = DisplayError(g_SharedState.Display);
+    DisconnectDisplay();
+    return YK_RESULT_FAILURE(error);
+  }
+
+  if (!g_SharedState.Compositor) {
+    DisconnectDisplay();
+    return YK_RESULT_FAILURE(Error::Create("The compositor does not advertise wl_compositor"));
+  }
+
+  // Second roundtrip delivers the mode/scale/name events of the outputs bound above
+  wl_display_roundtrip(g_SharedState.Display);
+
+  if (g_SharedState.XDG)
+    xdg_wm_base_add_listener(g_SharedState.XDG, &XDG_LISTENER, nullptr);
+  return YK_RESULT_SUCCESS({});
+}
 
 template <>
 Result<> Window<Wayland>::MakeLayer() {
-  // clang-format off
-    do { wl_display_roundtrip(g_SharedState.Display); }
-    while (!g_SharedState.ZWLR);
-  // clang-format on
+  if (!g_SharedState.ZWLR)
+    return YK_RESULT_FAILURE(Error::Create("The compositor does not support wlr-layer-shell"));
+
+  // Without an explicit output the compositor places the layer (usually on the focused output)
+  wl_output *output = nullptr;
+  if (m_CreateInfo.Output) {
+    auto found = std::find_if(g_SharedState.Outputs.begin(), g_SharedState.Outputs.end(),
+                              [&](const auto &o) { return o->RegistryName == *m_CreateInfo.Output; });
+    if (found == g_SharedState.Outputs.end())
+      return YK_RESULT_FAILURE(Error::Create(std::format("Output {} does not exist", *m_CreateInfo.Output)));
+    output = (*found)->Handle;
+  }
 
-  bool ready = false;
-  m_Layer = zwlr_layer_shell_v1_get_layer_surface(g_SharedState.ZWLR, m_Handle, g_SharedState.Output, ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY, m_CreateInfo.Title.c_str());
+  m_Layer = zwlr_layer_shell_v1_get_layer_surface(g_SharedState.ZWLR, m_Handle, output, ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY, m_CreateInfo.Title.c_str());
   if (!m_Layer)
     return YK_RESULT_FAILURE(Error::Create("zwlr_layer_shell_v1_get_layer_surface failed"));
 
   zwlr_layer_surface_v1_set_size(m_Layer, m_CreateInfo.Width, m_CreateInfo.Height);
   zwlr_layer_surface_v1_set_anchor(m_Layer, ZWLR_LAYER_SURFACE_V1_ANCHOR_RIGHT | ZWLR_LAYER_SURFACE_V1_ANCHOR_BOTTOM);
-  zwlr_layer_surface_v1_add_listener(m_Layer, &ZWLR_LISTENER, static_cast<void *>(&ready));
+  zwlr_layer_surface_v1_add_listener(m_Layer, &ZWLR_LISTENER, static_cast<void *>(&m_State));
 
   wl_surface_set_opaque_region(m_Handle, nullptr);
   wl_region *region = wl_compositor_create_region(g_SharedState.Compositor);
@@ -43,44 +132,66 @@ Result<> Window<Wayland>::MakeLayer() {
 
   wl_surface_commit(m_Handle);
 
-  // clang-format off
-  do { wl_display_roundtrip(g_SharedState.Display); } 
-  while (!ready);
-  // clang-format on
+  while (!m_State.Configured && !m_State.Closed) {
+    if (wl_display_roundtrip(g_SharedState.Display) < 0)
+      return YK_RESULT_FAILURE(DisplayError(g_SharedState.Display));
+  }
+
+  if (m_State.Closed)
+    return YK_RESULT_FAILURE(Error::Create("Layer surface was closed before its first configure"));
 
   return YK_RESULT_SUCCESS({});
 }
 
 template <>
 Result<> Window<Wayland>::Init() {
-  if (Window<Wayland>::s_WindowCount == 0) {
-    if (g_SharedState.Display = wl_display_connect(nullptr); !g_SharedState.Display)
-      return YK_RESULT_FAILURE(Error::Create("wl_display_connect failed"));
-
-    if (g_SharedState.Registery = wl_display_get_registry(g_SharedState.Display); !g_SharedState.Registery)
-      return YK_RESULT_FAILURE(Error::Create("wl_display_get_registry failed"));
+  if (auto result = ConnectDisplay(); !result)
+    return YK_RESULT_FAILURE(result.error());
 
-    wl_registry_add_listener(g_SharedState.Registery, &REGESTRY_LISTENER, nullptr);
+  if (m_Handle = wl_compositor_create_surface(g_SharedState.Compositor); !m_Handle)
+    return YK_RESULT_FAILURE(Error::Create("wl_compositor_create_surface failed"));
+  // Counted as soon as the surface exists, the destructor releases it even when Init fails later on
+  Window<Wayland>::s_WindowCount++;
 
-    // clang-format off
-    do { wl_display_roundtrip(g_SharedState.Display); }
-    while (!g_SharedState.Compositor || !g_SharedState.XDG || !g_SharedState.Output);
-    // clang-format on
+  // Both are optional, without them the buffer is shown 1:1 at the logical size
+  if (g_SharedState.Viewporter)
+    m_Viewport = wp_viewporter_get_viewport(g_SharedState.Viewporter, m_Handle);
 
-    xdg_wm_base_add_listener(g_SharedState.XDG, &XDG_LISTENER, nullptr);
+  if (g_SharedState.FractionalScale) {
+    m_FractionalScale = wp_fractional_scale_manager_v1_get_fractional_scale(g_SharedState.FractionalScale, m_Handle);
+    wp_fractional_scale_v1_add_listener(m_FractionalScale, &FRACTIONAL_SCALE_LISTENER, static_cast<void *>(&m_Scale));
   }
 
-  if (m_Handle = wl_compositor_create_surface(g_SharedState.Compositor); !m_Handle)
-    return YK_RESULT_FAILURE(Error::Create("wl_compositor_create_surface failed"));
-
-  if (m_CreateInfo.IsLayer)
+  if (m_CreateInfo.IsLayer) {
     if (auto result = MakeLayer(); !result)
       return YK_RESULT_FAILURE(result.error());
+  } else {
+    m_State.Configured = true;
+  }
+
+  // Renders at the logical size until the application picks another extent, no viewport is needed for it
+  m_RenderExtent = {m_CreateInfo.Width, m_CreateInfo.Height};
+  m_Damage.SetExtent(m_RenderExtent.Width, m_RenderExtent.Height);
 
   wl_surface_commit(m_Handle);
   return YK_RESULT_SUCCESS({});
 }
 
+template <>
+bool Window<Wayland>::SetRenderExtent(const Extent &extent) {
+  if (!m_Viewport)
+    return false;
+
+  // Source in buffer pixels, destination in logical surface coordinates, applied on the next commit
+  wp_viewport_set_source(m_Viewport, wl_fixed_from_int(0), wl_fixed_from_int(0),
+                         wl_fixed_from_int(static_cast<int32_t>(extent.Width)), wl_fixed_from_int(static_cast<int32_t>(extent.Height)));
+  wp_viewport_set_destination(m_Viewport, static_cast<int32_t>(m_CreateInfo.Width), static_cast<int32_t>(m_CreateInfo.Height));
+
+  m_RenderExtent = extent;
+  m_Damage.SetExtent(extent.Width, extent.Height);
+  return true;
+}
+
 template <>
 Result<std::unique_ptr<Window<Wayland>>> Window<Wayland>::Create(const WindowCreateInfo &ci) {
   auto window = std::unique_ptr<Window<Wayland>>(new Window<Wayland>);
@@ -89,19 +200,92 @@ Result<std::unique_ptr<Window<Wayland>>> Window<Wayland>::Create(const WindowCre
   if (auto result = window->Init(); !result)
     return YK_RESULT_FAILURE(result.error());
 
-  Window<Wayland>::s_WindowCount++;
   return YK_RESULT_SUCCESS(window);
 }
 
 template <>
-void Window<Wayland>::Frame() const {
-  wl_display_dispatch(g_SharedState.Display);
-  wl_display_flush(g_SharedState.Display);
-  wl_surface_commit(m_Handle);
+void Window<Wayland>::Present() {
+  YK_PROFILE_FUNCTION();
+  if (ShouldRender() && !m_State.Closed) {
+    // Buffer damage needs wl_surface v4, older compositors only get surface-local damage
+    // Rects are in buffer pixels, the viewport maps the render extent onto the logical size
+    const bool bufferDamage = g_SharedState.CompositorVersion >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION;
+    const float scaleX = static_cast<float>(m_CreateInfo.Width) / static_cast<float>(std::max(m_RenderExtent.Width, 1U));
+    const float scaleY = static_cast<float>(m_CreateInfo.Height) / static_cast<float>(std::max(m_RenderExtent.Height, 1U));
+    for (const auto &rect : m_Damage.GetRects()) {
+      if (bufferDamage) {
+        wl_surface_damage_buffer(m_Handle, rect.X, rect.Y, static_cast<int32_t>(rect.Width), static_cast<int32_t>(rect.Height));
+        continue;
+      }
+
+      // Rounded outwards so partially covered surface pixels are damaged too
+      const auto left = static_cast<int32_t>(std::floor(static_cast<float>(rect.X) * scaleX));
+      const auto top = static_cast<int32_t>(std::floor(static_cast<float>(rect.Y) * scaleY));
+      const auto right = static_cast<int32_t>(std::ceil(static_cast<float>(rect.Right()) * scaleX));
+      const auto bottom = static_cast<int32_t>(std::ceil(static_cast<float>(rect.Bottom()) * scaleY));
+      wl_surface_damage(m_Handle, left, top, right - left, bottom - top);
+    }
+
+    // The next frame is held back until the compositor signals it wants one
+    m_FrameCallback = wl_surface_frame(m_Handle);
+    wl_callback_add_listener(m_FrameCallback, &FRAME_LISTENER, static_cast<void *>(&m_FrameCallback));
+    g_SharedState.PendingFrames++;
+    wl_surface_commit(m_Handle);
+    m_Damage.Clear();
+  }
+}
+
+template <>
+Result<> Window<Wayland>::DispatchEvents(uint32_t timeoutMs) {
+  if (!g_SharedState.Display)
+    return YK_RESULT_FAILURE(Error::Create("Not connected to a Wayland display"));
+
+  // Blocking on a frame callback is reported as present wait, sleeping through an idle tick is not
+  const bool presenting = g_SharedState.PendingFrames > 0;
+  const uint64_t waitBegin = Profiler::Now();
+  auto result = WaitForEvents(static_cast<int>(timeoutMs));
+  if (presenting)
+    Profiler::AddPresentWait(Profiler::Now() - waitBegin);
+  return result;
+}
+
+template <>
+Result<std::vector<OutputInfo>> Window<Wayland>::EnumerateOutputs() {
+  if (auto result = ConnectDisplay(); !result)
+    return YK_RESULT_FAILURE(result.error());
+
+  std::vector<OutputInfo> outputs;
+  for (const auto &output : g_SharedState.Outputs) {
+    // Hotplugged outputs are listed once their first batch of properties arrived
+    if (output->Version >= WL_OUTPUT_DONE_SINCE_VERSION && !output->Done)
+      continue;
+
+    outputs.push_back({
+        .ID = output->RegistryName,
+        .Name = output->Name,
+        .Description = output->Description,
+        .Width = static_cast<uint32_t>(output->Width),
+        .Height = static_cast<uint32_t>(output->Height),
+        .RefreshMilliHz = static_cast<uint32_t>(output->RefreshMilliHz),
+        .Scale = static_cast<float>(output->Scale),
+    });
+  }
+  return outputs;
 }
 
 template <>
 Window<Wayland>::~Window() {
+  if (m_FrameCallback) {
+    wl_callback_destroy(m_FrameCallback);
+    g_SharedState.PendingFrames--;
+  }
+
+  if (m_FractionalScale)
+    wp_fractional_scale_v1_destroy(m_FractionalScale);
+
+  if (m_Viewport)
+    wp_viewport_destroy(m_Viewport);
+
   if (m_Layer)
     zwlr_layer_surface_v1_destroy(m_Layer);
 
@@ -110,27 +294,113 @@ Window<Wayland>::~Window() {
     Window<Wayland>::s_WindowCount--;
   }
 
-  if (Window<Wayland>::s_WindowCount == 0) {
-    wl_display_disconnect(g_SharedState.Display);
-    g_SharedState = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
-  }
+  // Init may have failed before connecting, there is nothing to tear down then
+  if (Window<Wayland>::s_WindowCount == 0 && g_SharedState.Display)
+    DisconnectDisplay();
 }
 
 void RegisteryAdd(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version) {
-  if (std::string_view(interface) == wl_compositor_interface.name)
+  if (std::string_view(interface) == wl_compositor_interface.name) {
     g_SharedState.Compositor = static_cast<wl_compositor *>(wl_registry_bind(registry, name, &wl_compositor_interface, version));
+    g_SharedState.CompositorVersion = version;
+  }
   else if (std::string_view(interface) == xdg_wm_base_interface.name)
     g_SharedState.XDG = static_cast<xdg_wm_base *>(wl_registry_bind(registry, name, &xdg_wm_base_interface, version));
   else if (std::string_view(interface) == zwlr_layer_shell_v1_interface.name)
     g_SharedState.ZWLR = static_cast<zwlr_layer_shell_v1 *>(wl_registry_bind(registry, name, &zwlr_layer_shell_v1_interface, version));
-  else if (std::string_view(interface) == wl_output_interface.name)
-    g_SharedState.Output = static_cast<wl_output *>(wl_registry_bind(registry, name, &wl_output_interface, version));
+  else if (std::string_view(interface) == wp_viewporter_interface.name)
+    g_SharedState.Viewporter = static_cast<wp_viewporter *>(wl_registry_bind(registry, name, &wp_viewporter_interface, 1));
+  else if (std::string_view(interface) == wp_fractional_scale_manager_v1_interface.name)
+    g_SharedState.FractionalScale = static_cast<wp_fractional_scale_manager_v1 *>(wl_registry_bind(registry, name, &wp_fractional_scale_manager_v1_interface, 1));
+  else if (std::string_view(interface) == wl_output_interface.name) {
+    // name/description arrive from version 4 on, older outputs keep empty strings
+    auto output = std::make_unique<WaylandOutput>();
+    output->RegistryName = name;
+    output->Version = std::min(version, 4U);
+    output->Handle = static_cast<wl_output *>(wl_registry_bind(registry, name, &wl_output_interface, output->Version));
+    wl_output_add_listener(output->Handle, &OUTPUT_LISTENER, output.get());
+    g_SharedState.Outputs.emplace_back(std::move(output));
+  }
 }
 
+// Layer surfaces on a removed output receive zwlr_layer_surface_v1.closed on their own
+void RegisteryRemove(void *data, struct wl_registry *registry, uint32_t name) {
+  auto &outputs = g_SharedState.Outputs;
+  auto found = std::find_if(outputs.begin(), outputs.end(), [&](const auto &o) { return o->RegistryName == name; });
+  if (found == outputs.end())
+    return;
+
+  ReleaseOutput(**found);
+  outputs.erase(found);
+}
+
+// Only the current mode is kept, refresh is in mHz
+void OutputMode(void *data, wl_output *output, uint32_t flags, int32_t width, int32_t height, int32_t refresh) {
+  if (!(flags & WL_OUTPUT_MODE_CURRENT))
+    return;
+
+  auto *state = static_cast<WaylandOutput *>(data);
+  state->Width = width;
+  state->Height = height;
+  state->RefreshMilliHz = refresh;
+}
+
+void OutputDone(void *data, wl_output *output) { static_cast<WaylandOutput *>(data)->Done = true; }
+void OutputScale(void *data, wl_output *output, int32_t factor) { static_cast<WaylandOutput *>(data)->Scale = factor; }
+void OutputName(void *data, wl_output *output, const char *name) { static_cast<WaylandOutput *>(data)->Name = name; }
+void OutputDescription(void *data, wl_output *output, const char *description) { static_cast<WaylandOutput *>(data)->Description = description; }
+
 void ZWLRConfigure(void *data, zwlr_layer_surface_v1 *surface, uint32_t serial, uint32_t width, uint32_t height) {
   zwlr_layer_surface_v1_ack_configure(surface, serial);
-  bool *configured = static_cast<bool *>(data);
-  *configured = true;
+  static_cast<SurfaceState *>(data)->Configured = true;
+}
+
+void ZWLRClosed(void *data, zwlr_layer_surface_v1 *surface) {
+  static_cast<SurfaceState *>(data)->Closed = true;
+}
+
+void FrameDone(void *data, wl_callback *callback, uint32_t time) {
+  wl_callback **pending = static_cast<wl_callback **>(data);
+  *pending = nullptr;
+  wl_callback_destroy(callback);
+  g_SharedState.PendingFrames--;
+}
+
+// The scale is sent as a fraction of 120, the application picks it up through Window::GetScale
+void PreferredScale(void *data, wp_fractional_scale_v1 *fractionalScale, uint32_t scale) {
+  float *preferred = static_cast<float *>(data);
+  *preferred = static_cast<float>(scale) / 120.0f;
+}
+
+// Dispatches queued events, then sleeps on the display fd for at most timeoutMs (-1 blocks)
+// After a compositor disconnect poll returns POLLHUP at once, reading then fails and so does this call
+Result<> WaitForEvents(int timeoutMs) {
+  wl_display *display = g_SharedState.Display;
+  while (wl_display_prepare_read(display) != 0) {
+    if (wl_display_dispatch_pending(display) < 0)
+      return YK_RESULT_FAILURE(DisplayError(display));
+  }
+
+  // EAGAIN only means the socket is full, the rest goes out on the next call
+  if (wl_display_flush(display) < 0 && errno != EAGAIN) {
+    wl_display_cancel_read(display);
+    return YK_RESULT_FAILURE(DisplayError(display));
+  }
+
+  pollfd fd{.fd = wl_display_get_fd(display), .events = POLLIN, .revents = 0};
+  const int ready = poll(&fd, 1, timeoutMs);
+  if (ready > 0) {
+    if (wl_display_read_events(display) < 0)
+      return YK_RESULT_FAILURE(DisplayError(display));
+  } else {
+    wl_display_cancel_read(display);
+    if (ready < 0 && errno != EINTR)
+      return YK_RESULT_FAILURE(Error::Create(std::format("poll on the Wayland display failed: {}", std::strerror(errno))));
+  }
+
+  if (wl_display_dispatch_pending(display) < 0)
+    return YK_RESULT_FAILURE(DisplayError(display));
+  return YK_RESULT_SUCCESS({});
 }
 
 } // namespace york
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "York/Scene/bvh.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
+#include <algorithm>
+#include <bit>
+#include <format>
+
+namespace york {
+
+// =====================
+// Construction
+// =====================
+// Median split on the longest centroid axis
+static std::pair<std::span<uint32_t>, std::span<uint32_t>> Split(std::span<uint32_t> primitives, const std::vector<AABB> &bounds) {
+  AABB centroids{bounds[primitives[0]].Center(), bounds[primitives[0]].Center()};
+  for (uint32_t primitive : primitives)
+    centroids = Union(centroids, {bounds[primitive].Center(), bounds[primitive].Center()});
+
+  const Vec3 size = centroids.Max - centroids.Min;
+  const int axis = size.X >= size.Y && size.X >= size.Z ? 0 : (size.Y >= size.Z ? 1 : 2);
+  auto key = [&](uint32_t primitive) {
+    const Vec3 c = bounds[primitive].Center();
+    return axis == 0 ? c.X : (axis == 1 ? c.Y : c.Z);
+  };
+
+  const size_t middle = primitives.size() / 2;
+  std::nth_element(primitives.begin(), primitives.begin() + static_cast<std::ptrdiff_t>(middle), primitives.end(),
+                   [&](uint32_t a, uint32_t b) { return key(a) < key(b); });
+  return {primitives.first(middle), primitives.subspan(middle)};
+}
+
+static void SetSlot(float *minX, float *minY, float *minZ, float *maxX, float *maxY, float *maxZ, uint32_t slot, const AABB &box) {
+  minX[slot] = box.Min.X;
+  minY[slot] = box.Min.Y;
+  minZ[slot] = box.Min.Z;
+  maxX[slot] = box.Max.X;
+  maxY[slot] = box.Max.Y;
+  maxZ[slot] = box.Max.Z;
+}
+
+Result<std::unique_ptr<BVH>> BVH::Create(const BVHCreateInfo &createInfo) {
+  auto bvh = std::unique_ptr<BVH>(new BVH());
+  const uint32_t count = static_cast<uint32_t>(createInfo.Bounds.size());
+
+  for (uint32_t i(0); i < count; ++i) {
+    const auto &box = createInfo.Bounds[i];
+    if (!(box.Min.X <= box.Max.X && box.Min.Y <= box.Max.Y && box.Min.Z <= box.Max.Z))
+      return YK_RESULT_FAILURE(Error::Create(std::format("Primitive {} has inverted or NaN bounds", i)));
+  }
+
+  bvh->m_PrimitiveNodes.resize(count);
+  if (count == 0)
+    return YK_RESULT_SUCCESS(bvh);
+
+  std::vector<uint32_t> primitives(count);
+  for (uint32_t i(0); i < count; ++i)
+    primitives[i] = i;
+
+  // A 4-wide tree has roughly count / 3 nodes
+  bvh->m_Nodes.reserve(count / 3 + 1);
+  bvh->Build(primitives, createInfo.Bounds, UINT32_MAX);
+  bvh->m_Dirty.assign(bvh->m_Nodes.size(), 0);
+  return YK_RESULT_SUCCESS(bvh);
+}
+
+uint32_t BVH::Build(std::span<uint32_t> primitives, const std::vector<AABB> &bounds, uint32_t parent) {
+  const uint32_t index = static_cast<uint32_t>(m_Nodes.size());
+  m_Nodes.emplace_back();
+  m_Nodes[index].Parent = parent;
+
+  std::span<uint32_t> groups[WIDTH];
+  uint32_t groupCount = 0;
+  if (primitives.size() <= WIDTH) {
+    for (size_t i(0); i < primitives.size(); ++i)
+      groups[groupCount++] = primitives.subspan(i, 1);
+  } else {
+    auto [left, right] = Split(primitives, bounds);
+    for (auto half : {left, right}) {
+      auto [a, b] = Split(half, bounds);
+      groups[groupCount++] = a;
+      groups[groupCount++] = b;
+    }
+  }
+
+  for (uint32_t slot(0); slot < groupCount; ++slot) {
+    AABB box;
+    int32_t child;
+    if (groups[slot].size() == 1) {
+      const uint32_t primitive = groups[slot][0];
+      box = bounds[primitive];
+      child = ~static_cast<int32_t>(primitive);
+      m_PrimitiveNodes[primitive] = {index, slot};
+    } else {
+      // Build grows m_Nodes, only hold indices across the call
+      const uint32_t childNode = Build(groups[slot], bounds, index);
+      const auto &c = m_Nodes[childNode];
+      box = {{c.MinX[0], c.MinY[0], c.MinZ[0]}, {c.MaxX[0], c.MaxY[0], c.MaxZ[0]}};
+      for (uint32_t i(1); i < c.Count; ++i)
+        box = Union(box, {{c.MinX[i], c.MinY[i], c.MinZ[i]}, {c.MaxX[i], c.MaxY[i], c.MaxZ[i]}});
+      child = static_cast<int32_t>(childNode);
+    }
+
+    auto &node = m_Nodes[index];
+    SetSlot(node.MinX, node.MinY, node.MinZ, node.MaxX, node.MaxY, node.MaxZ, slot, box);
+    node.Children[slot] = child;
+  }
+
+  // Unused slots are never tested (masked by Count), zero them so SIMD loads stay finite
+  auto &node = m_Nodes[index];
+  node.Count = groupCount;
+  for (uint32_t slot = groupCount; slot < WIDTH; ++slot) {
+    SetSlot(node.MinX, node.MinY, node.MinZ, node.MaxX, node.MaxY, node.MaxZ, slot, {});
+    node.Children[slot] = 0;
+  }
+  return index;
+}
+
+// =====================
+// Refit
+// =====================
+void BVH::MarkDirty(uint32_t node) noexcept {
+  while (node != UINT32_MAX && !m_Dirty[node]) {
+    m_Dirty[node] = 1;
+    node = m_Nodes[node].Parent;
+  }
+  m_AnyDirty = true;
+}
+
+void BVH::SetBounds(uint32_t primitive, const AABB &bounds) noexcept {
+  const auto [index, slot] = m_PrimitiveNodes[primitive];
+  auto &node = m_Nodes[index];
+  SetSlot(node.MinX, node.MinY, node.MinZ, node.MaxX, node.MaxY, node.MaxZ, slot, bounds);
+  MarkDirty(index);
+}
+
+AABB BVH::GetBounds(uint32_t primitive) const noexcept {
+  const auto [index, slot] = m_PrimitiveNodes[primitive];
+  const auto &node = m_Nodes[index];
+  return {{node.MinX[slot], node.MinY[slot], node.MinZ[slot]}, {node.MaxX[slot], node.MaxY[slot], node.MaxZ[slot]}};
+}
+
+void BVH::Refit() noexcept {
+  if (!m_AnyDirty)
+    return;
+
+  YK_PROFILE_FUNCTION();
+  // Pre-order storage: walking backwards visits children before parents
+  for (uint32_t n = static_cast<uint32_t>(m_Nodes.size()); n-- > 0;) {
+    if (!m_Dirty[n])
+      continue;
+
+    auto &node = m_Nodes[n];
+    for (uint32_t slot(0); slot < node.Count; ++slot) {
+      if (node.Children[slot] < 0)
+        continue;
+
+      const auto &c = m_Nodes[static_cast<uint32_t>(node.Children[slot])];
+      AABB box{{c.MinX[0], c.MinY[0], c.MinZ[0]}, {c.MaxX[0], c.MaxY[0], c.MaxZ[0]}};
+      for (uint32_t i(1); i < c.Count; ++i)
+        box = Union(box, {{c.MinX[i], c.MinY[i], c.MinZ[i]}, {c.MaxX[i], c.MaxY[i], c.MaxZ[i]}});
+      SetSlot(node.MinX, node.MinY, node.MinZ, node.MaxX, node.MaxY, node.MaxZ, slot, box);
+    }
+    m_Dirty[n] = 0;
+  }
+  m_AnyDirty = false;
+}
+
+// =====================
+// Culling
+// =====================
+// Bit i of outside: child i is behind a plane, bit i of crossing: child i straddles a plane
+static void TestNode(const Frustum &f, const float *minX, const float *minY, const float *minZ, const float *maxX, const float *maxY,
+                     const float *maxZ, uint32_t &outside, uint32_t &crossing) {
+#if defined(YORK_SIMD_SSE)
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 lx = _mm_load_ps(minX), ly = _mm_load_ps(minY), lz = _mm_load_ps(minZ);
+  const __m128 hx = _mm_load_ps(maxX), hy = _mm_load_ps(maxY), hz = _mm_load_ps(maxZ);
+  const __m128 cx = _mm_mul_ps(_mm_add_ps(hx, lx), half), ex = _mm_mul_ps(_mm_sub_ps(hx, lx), half);
+  const __m128 cy = _mm_mul_ps(_mm_add_ps(hy, ly), half), ey = _mm_mul_ps(_mm_sub_ps(hy, ly), half);
+  const __m128 cz = _mm_mul_ps(_mm_add_ps(hz, lz), half), ez = _mm_mul_ps(_mm_sub_ps(hz, lz), half);
+
+  __m128 out = _mm_setzero_ps(), cross = _mm_setzero_ps();
+  for (uint32_t p(0); p < Frustum::PLANE_COUNT; ++p) {
+    __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.NX[p]), cx), _mm_set1_ps(f.D[p]));
+    dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.NY[p]), cy), dist);
+    dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.NZ[p]), cz), dist);
+    __m128 radius = _mm_mul_ps(_mm_set1_ps(f.AbsNX[p]), ex);
+    radius = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.AbsNY[p]), ey), radius);
+    radius = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.AbsNZ[p]), ez), radius);
+
+    out = _mm_or_ps(out, _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+    cross = _mm_or_ps(cross, _mm_cmplt_ps(_mm_sub_ps(dist, radius), _mm_setzero_ps()));
+  }
+  outside = static_cast<uint32_t>(_mm_movemask_ps(out));
+  crossing = static_cast<uint32_t>(_mm_movemask_ps(cross));
+#else
+  outside = crossing = 0;
+  for (uint32_t i(0); i < BVH::WIDTH; ++i) {
+    const float cx = (maxX[i] + minX[i]) * 0.5f, ex = (maxX[i] - minX[i]) * 0.5f;
+    const float cy = (maxY[i] + minY[i]) * 0.5f, ey = (maxY[i] - minY[i]) * 0.5f;
+    const float cz = (maxZ[i] + minZ[i]) * 0.5f, ez = (maxZ[i] - minZ[i]) * 0.5f;
+    for (uint32_t p(0); p < Frustum::PLANE_COUNT; ++p) {
+      const float dist = f.NX[p] * cx + f.NY[p] * cy + f.NZ[p] * cz + f.D[p];
+      const float radius = f.AbsNX[p] * ex + f.AbsNY[p] * ey + f.AbsNZ[p] * ez;
+      if (dist + radius < 0.0f)
+        outside |= 1U << i;
+      if (dist - radius < 0.0f)
+        crossing |= 1U << i;
+    }
+  }
+#endif
+}
+
+void BVH::Gather(uint32_t index, std::vector<uint32_t> &visible) const {
+  const auto &node = m_Nodes[index];
+  for (uint32_t slot(0); slot < node.Count; ++slot) {
+    if (node.Children[slot] < 0)
+      visible.push_back(static_cast<uint32_t>(~node.Children[slot]));
+    else
+      Gather(static_cast<uint32_t>(node.Children[slot]), visible);
+  }
+}
+
+void BVH::Cull(const Frustum &frustum, std::vector<uint32_t> &visible) const {
+  YK_PROFILE_FUNCTION();
+  if (m_Nodes.empty())
+    return;
+
+  // Depth is about log4(n), a small fixed stack is enough for any realistic scene
+  uint32_t stack[256];
+  uint32_t top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const auto &node = m_Nodes[stack[--top]];
+    uint32_t outside, crossing;
+    TestNode(frustum, node.MinX, node.MinY, node.MinZ, node.MaxX, node.MaxY, node.MaxZ, outside, crossing);
+
+    uint32_t mask = ~outside & ((1U << node.Count) - 1);
+    while (mask) {
+      const uint32_t slot = static_cast<uint32_t>(std::countr_zero(mask));
+      mask &= mask - 1;
+
+      const int32_t child = node.Children[slot];
+      if (child < 0)
+        visible.push_back(static_cast<uint32_t>(~child));
+      else if (!(crossing & (1U << slot)))
+        Gather(static_cast<uint32_t>(child), visible);
+      else if (top < std::size(stack))
+        stack[top++] = static_cast<uint32_t>(child);
+      else
+        Gather(static_cast<uint32_t>(child), visible);
+    }
+  }
+}
+} // namespace york
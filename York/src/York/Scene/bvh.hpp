@@ -0,0 +1,79 @@
+#pragma once
+
+/*
+ * 4-wide Bounding Volume Hierarchy
+ */
+
+#include "York/Core/result.hpp"
+#include "York/Math/math.hpp"
+#include "York/Scene/culling.hpp"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace york {
+
+// Bounds is one AABB per primitive (instance or meshlet), primitive IDs are indices into it
+struct BVHCreateInfo {
+  std::vector<AABB> Bounds;
+};
+
+// Every node holds the bounds of up to 4 children in SoA, so one SIMD test covers all of them
+// A child is either another node or a single primitive
+// Usage:
+// bvh->SetBounds(primitive, box) for moved primitives, bvh->Refit(), then bvh->Cull(frustum, visible)
+// Refit keeps the topology and only rewrites the bounds on the path from changed primitives to the root
+// Quality degrades if primitives move far from where they were built, Create a new one then
+class BVH {
+public:
+  static constexpr uint32_t WIDTH = 4;
+
+  static Result<std::unique_ptr<BVH>> Create(const BVHCreateInfo &createInfo);
+
+public:
+  void SetBounds(uint32_t primitive, const AABB &bounds) noexcept;
+  void Refit() noexcept;
+
+  // Appends every primitive whose AABB touches the frustum, subtrees fully inside skip the plane tests
+  void Cull(const Frustum &frustum, std::vector<uint32_t> &visible) const;
+
+  AABB GetBounds(uint32_t primitive) const noexcept;
+  uint32_t GetPrimitiveCount() const noexcept { return static_cast<uint32_t>(m_PrimitiveNodes.size()); }
+  uint32_t GetNodeCount() const noexcept { return static_cast<uint32_t>(m_Nodes.size()); }
+
+private:
+  BVH() = default;
+
+  uint32_t Build(std::span<uint32_t> primitives, const std::vector<AABB> &bounds, uint32_t parent);
+  void Gather(uint32_t node, std::vector<uint32_t> &visible) const;
+  void MarkDirty(uint32_t node) noexcept;
+
+public:
+  ~BVH() = default;
+  BVH(const BVH &) = delete;
+  BVH &operator=(const BVH &) = delete;
+
+private:
+  // Child >= 0 is a node index, < 0 is primitive ~Child
+  // Nodes are stored in pre-order, children always come after their parent
+  struct alignas(16) Node {
+    float MinX[WIDTH], MinY[WIDTH], MinZ[WIDTH];
+    float MaxX[WIDTH], MaxY[WIDTH], MaxZ[WIDTH];
+    int32_t Children[WIDTH];
+    uint32_t Count = 0;
+    uint32_t Parent = UINT32_MAX;
+  };
+
+  struct Slot {
+    uint32_t Node = 0;
+    uint32_t Child = 0;
+  };
+
+private:
+  std::vector<Node> m_Nodes;
+  std::vector<uint8_t> m_Dirty;
+  std::vector<Slot> m_PrimitiveNodes;
+  bool m_AnyDirty = false;
+};
+} // namespace york
@@ -0,0 +1,143 @@
+#include "York/Scene/culling.hpp"
+#include "York/Core/profiler.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace york {
+
+// Padding spheres have an infinitely negative radius and are outside every plane
+static constexpr uint32_t SPHERE_PADDING = 8;
+static constexpr float PADDING_RADIUS = -std::numeric_limits<float>::infinity();
+
+// =====================
+// Frustum
+// =====================
+Frustum Frustum::FromViewProjection(const Mat4 &m) noexcept {
+  // Rows of the matrix, planes come from the clip-space inequalities (Gribb/Hartmann)
+  auto row = [&](size_t r) { return std::array<float, 4>{m(r, 0), m(r, 1), m(r, 2), m(r, 3)}; };
+  const auto r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+  const std::array<float, 4> planes[PLANE_COUNT]{
+      {r3[0] + r0[0], r3[1] + r0[1], r3[2] + r0[2], r3[3] + r0[3]}, // left
+      {r3[0] - r0[0], r3[1] - r0[1], r3[2] - r0[2], r3[3] - r0[3]}, // right
+      {r3[0] + r1[0], r3[1] + r1[1], r3[2] + r1[2], r3[3] + r1[3]}, // bottom
+      {r3[0] - r1[0], r3[1] - r1[1], r3[2] - r1[2], r3[3] - r1[3]}, // top
+      {r2[0], r2[1], r2[2], r2[3]},                                 // near (z >= 0)
+      {r3[0] - r2[0], r3[1] - r2[1], r3[2] - r2[2], r3[3] - r2[3]}, // far
+  };
+
+  Frustum frustum;
+  for (uint32_t i(0); i < PLANE_COUNT; ++i) {
+    const float length = std::sqrt(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+    const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+    frustum.NX[i] = planes[i][0] * inverse;
+    frustum.NY[i] = planes[i][1] * inverse;
+    frustum.NZ[i] = planes[i][2] * inverse;
+    frustum.D[i] = planes[i][3] * inverse;
+    frustum.AbsNX[i] = std::abs(frustum.NX[i]);
+    frustum.AbsNY[i] = std::abs(frustum.NY[i]);
+    frustum.AbsNZ[i] = std::abs(frustum.NZ[i]);
+  }
+  return frustum;
+}
+
+// =====================
+// Sphere Set
+// =====================
+void SphereSet::Reserve(size_t count) {
+  const size_t padded = (count + SPHERE_PADDING - 1) / SPHERE_PADDING * SPHERE_PADDING;
+  m_X.reserve(padded);
+  m_Y.reserve(padded);
+  m_Z.reserve(padded);
+  m_Radius.reserve(padded);
+}
+
+void SphereSet::Add(const Vec3 &center, float radius) {
+  if (m_Count == m_X.size()) {
+    const size_t padded = m_X.size() + SPHERE_PADDING;
+    m_X.resize(padded, 0.0f);
+    m_Y.resize(padded, 0.0f);
+    m_Z.resize(padded, 0.0f);
+    m_Radius.resize(padded, PADDING_RADIUS);
+  }
+  Set(m_Count++, center, radius);
+}
+
+void SphereSet::Set(uint32_t index, const Vec3 &center, float radius) noexcept {
+  m_X[index] = center.X;
+  m_Y[index] = center.Y;
+  m_Z[index] = center.Z;
+  m_Radius[index] = radius;
+}
+
+void SphereSet::Clear() noexcept {
+  m_Count = 0;
+  m_X.clear();
+  m_Y.clear();
+  m_Z.clear();
+  m_Radius.clear();
+}
+
+// =====================
+// Sphere Culling
+// =====================
+#if defined(YORK_SIMD_SSE) || defined(YORK_SIMD_AVX2)
+static void PushMask(std::vector<uint32_t> &visible, uint32_t base, uint32_t mask, uint32_t count) {
+  while (mask) {
+    const uint32_t index = base + static_cast<uint32_t>(std::countr_zero(mask));
+    if (index < count)
+      visible.push_back(index);
+    mask &= mask - 1;
+  }
+}
+#endif
+
+void CullSpheres(const Frustum &frustum, const SphereSet &spheres, std::vector<uint32_t> &visible) {
+  YK_PROFILE_FUNCTION();
+  const uint32_t count = spheres.m_Count;
+  const float *xs = spheres.m_X.data();
+  const float *ys = spheres.m_Y.data();
+  const float *zs = spheres.m_Z.data();
+  const float *rs = spheres.m_Radius.data();
+
+  // Storage is padded to 8, every path may read whole groups past m_Count
+  uint32_t i = 0;
+#if defined(YORK_SIMD_AVX2)
+  for (; i < count; i += 8) {
+    const __m256 x = _mm256_loadu_ps(xs + i), y = _mm256_loadu_ps(ys + i), z = _mm256_loadu_ps(zs + i);
+    const __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(rs + i));
+    __m256 outside = _mm256_setzero_ps();
+    for (uint32_t p(0); p < Frustum::PLANE_COUNT; ++p) {
+      __m256 dist = _mm256_fmadd_ps(_mm256_set1_ps(frustum.NX[p]), x, _mm256_set1_ps(frustum.D[p]));
+      dist = _mm256_fmadd_ps(_mm256_set1_ps(frustum.NY[p]), y, dist);
+      dist = _mm256_fmadd_ps(_mm256_set1_ps(frustum.NZ[p]), z, dist);
+      outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, negR, _CMP_LT_OQ));
+    }
+    PushMask(visible, i, ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu, count);
+  }
+#elif defined(YORK_SIMD_SSE)
+  for (; i < count; i += 4) {
+    const __m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i), z = _mm_loadu_ps(zs + i);
+    const __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(rs + i));
+    __m128 outside = _mm_setzero_ps();
+    for (uint32_t p(0); p < Frustum::PLANE_COUNT; ++p) {
+      __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.NX[p]), x), _mm_set1_ps(frustum.D[p]));
+      dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.NY[p]), y), dist);
+      dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.NZ[p]), z), dist);
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, negR));
+    }
+    PushMask(visible, i, ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFu, count);
+  }
+#else
+  for (; i < count; ++i) {
+    bool inside = true;
+    for (uint32_t p(0); p < Frustum::PLANE_COUNT && inside; ++p)
+      inside = frustum.NX[p] * xs[i] + frustum.NY[p] * ys[i] + frustum.NZ[p] * zs[i] + frustum.D[p] >= -rs[i];
+    if (inside)
+      visible.push_back(i);
+  }
+#endif
+}
+} // namespace york
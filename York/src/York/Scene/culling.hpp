@@ -0,0 +1,53 @@
+#pragma once
+
+/*
+ * Frustum Tests (SSE / AVX2 with a scalar fallback)
+ */
+
+#include "York/Math/math.hpp"
+#include "York/Math/simd.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace york {
+
+// Planes as n.p + d >= 0 inside, stored SoA so one plane is broadcast against several bounds
+// AbsN* caches |n| for the AABB radius
+struct Frustum {
+  static constexpr uint32_t PLANE_COUNT = 6;
+
+  alignas(16) float NX[PLANE_COUNT];
+  alignas(16) float NY[PLANE_COUNT];
+  alignas(16) float NZ[PLANE_COUNT];
+  alignas(16) float D[PLANE_COUNT];
+  alignas(16) float AbsNX[PLANE_COUNT];
+  alignas(16) float AbsNY[PLANE_COUNT];
+  alignas(16) float AbsNZ[PLANE_COUNT];
+
+  // Vulkan clip space (depth 0..1), planes are normalized so sphere radii compare directly
+  static Frustum FromViewProjection(const Mat4 &viewProjection) noexcept;
+};
+
+// Bounding spheres in SoA (e.g. meshlet bounds), padded to a multiple of 8 by Add
+class SphereSet {
+public:
+  void Reserve(size_t count);
+  void Add(const Vec3 &center, float radius);
+  void Set(uint32_t index, const Vec3 &center, float radius) noexcept;
+  void Clear() noexcept;
+
+  uint32_t GetCount() const noexcept { return m_Count; }
+
+private:
+  friend void CullSpheres(const Frustum &, const SphereSet &, std::vector<uint32_t> &);
+
+  uint32_t m_Count = 0;
+  std::vector<float> m_X;
+  std::vector<float> m_Y;
+  std::vector<float> m_Z;
+  std::vector<float> m_Radius;
+};
+
+// Appends the index of every sphere touching the frustum, 8 (AVX2) or 4 (SSE) spheres per step
+void CullSpheres(const Frustum &frustum, const SphereSet &spheres, std::vector<uint32_t> &visible);
+} // namespace york
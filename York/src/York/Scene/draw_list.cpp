@@ -0,0 +1,98 @@
+#include "York/Scene/draw_list.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/profiler.hpp"
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <utility>
+
+namespace york {
+
+// =====================
+// Draw List Creation
+// =====================
+Result<std::unique_ptr<DrawList>> DrawList::Create(const DrawListCreateInfo &createInfo) {
+  auto list = std::unique_ptr<DrawList>(new DrawList());
+  list->m_Objects = createInfo.Objects;
+
+  BVHCreateInfo bvhCI;
+  bvhCI.Bounds.reserve(createInfo.Objects.size());
+  for (uint32_t i(0); i < createInfo.Objects.size(); ++i) {
+    const auto &object = createInfo.Objects[i];
+    if (object.LODCount == 0 || object.LODCount > DrawObject::MAX_LODS)
+      return YK_RESULT_FAILURE(Error::Create(std::format("Object {} has {} LODs, expected 1 to {}", i, object.LODCount, DrawObject::MAX_LODS)));
+    bvhCI.Bounds.push_back(object.Bounds);
+  }
+
+  auto bvh = BVH::Create(bvhCI);
+  if (!bvh)
+    return YK_RESULT_FAILURE(bvh.error());
+  list->m_BVH = std::move(*bvh);
+
+  return YK_RESULT_SUCCESS(list);
+}
+
+// =====================
+// Draw List Building
+// =====================
+float DrawList::ProjectedSize(const AABB &bounds, const Vec3 &eye, float tanHalfFovY) noexcept {
+  const float radius = Length(bounds.Extent());
+  const float distance = Length(bounds.Center() - eye);
+  // The camera is inside the sphere, treat it as covering the whole view
+  if (distance <= radius)
+    return 1.0f;
+  return radius / (distance * tanHalfFovY);
+}
+
+// LSD radix sort on 8-bit digits, passes where every key shares the digit are skipped
+static void SortByKey(std::vector<DrawItem> &items, std::vector<DrawItem> &scratch) {
+  scratch.resize(items.size());
+  for (uint32_t shift(0); shift < 64; shift += 8) {
+    uint32_t histogram[256]{};
+    for (const auto &item : items)
+      histogram[(item.Key >> shift) & 0xFF]++;
+    if (histogram[(items[0].Key >> shift) & 0xFF] == items.size())
+      continue;
+
+    uint32_t offset = 0;
+    for (auto &bucket : histogram)
+      offset += std::exchange(bucket, offset);
+    for (const auto &item : items)
+      scratch[histogram[(item.Key >> shift) & 0xFF]++] = item;
+    items.swap(scratch);
+  }
+}
+
+const std::vector<DrawItem> &DrawList::Build(const DrawView &view) {
+  YK_PROFILE_FUNCTION();
+  m_BVH->Refit();
+
+  m_Visible.clear();
+  m_BVH->Cull(Frustum::FromViewProjection(view.ViewProjection), m_Visible);
+
+  m_Items.clear();
+  for (uint32_t index : m_Visible) {
+    const auto &object = m_Objects[index];
+    const AABB bounds = m_BVH->GetBounds(index);
+    const float size = ProjectedSize(bounds, view.Eye, view.TanHalfFovY);
+    if (size < view.MinScreenSize)
+      continue;
+
+    uint32_t lod = 0;
+    while (lod + 1 < object.LODCount && size < object.LODScreenSizes[lod])
+      lod++;
+
+    // Non-negative floats order like their bit patterns
+    const float distance = std::max(Length(bounds.Center() - view.Eye), 0.0f);
+    m_Items.push_back({
+        .Key = (static_cast<uint64_t>(object.SortKey) << 32) | std::bit_cast<uint32_t>(distance),
+        .Object = index,
+        .LOD = lod,
+    });
+  }
+
+  if (!m_Items.empty())
+    SortByKey(m_Items, m_Scratch);
+  return m_Items;
+}
+} // namespace york
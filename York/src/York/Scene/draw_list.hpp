@@ -0,0 +1,79 @@
+#pragma once
+
+/*
+ * CPU Visibility: BVH Culling, LOD Selection and Sorted Draw List
+ */
+
+#include "York/Core/result.hpp"
+#include "York/Math/math.hpp"
+#include "York/Scene/bvh.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace york {
+
+// SortKey groups draws sharing pipeline/material state, lower keys are drawn first
+// LODScreenSizes[i] is the projected size (see DrawList::ProjectedSize) below which LOD i + 1 is used
+struct DrawObject {
+  static constexpr uint32_t MAX_LODS = 4;
+
+  AABB Bounds{};
+  uint32_t SortKey = 0;
+  uint32_t LODCount = 1;
+  float LODScreenSizes[MAX_LODS - 1]{};
+};
+
+struct DrawListCreateInfo {
+  std::vector<DrawObject> Objects;
+};
+
+// Objects whose projected size (see DrawList::ProjectedSize) is below MinScreenSize are dropped entirely, 0 keeps everything
+struct DrawView {
+  Mat4 ViewProjection{};
+  Vec3 Eye{};
+  float TanHalfFovY = 1.0f;
+  float MinScreenSize = 0.0f;
+};
+
+// Key: SortKey in the high 32 bits, view distance in the low ones, so state groups draw front to back
+struct DrawItem {
+  uint64_t Key = 0;
+  uint32_t Object = 0;
+  uint32_t LOD = 0;
+};
+
+// Usage:
+// list->SetBounds(object, box) when an object moves (e.g. from TransformHierarchy::HasWorldChanged)
+// const auto &items = list->Build(view) once per view and frame
+// Moved objects are refit into the BVH, it is never rebuilt; the item array is reused between frames
+class DrawList {
+public:
+  static Result<std::unique_ptr<DrawList>> Create(const DrawListCreateInfo &createInfo);
+
+public:
+  void SetBounds(uint32_t object, const AABB &bounds) noexcept { m_BVH->SetBounds(object, bounds); }
+
+  const std::vector<DrawItem> &Build(const DrawView &view);
+  const std::vector<DrawItem> &GetItems() const noexcept { return m_Items; }
+
+  // Projected diameter of the bounding sphere as a fraction of the viewport height, 1.0 spans the whole height
+  // radius / (distance * tanHalfFovY) is the radius over the half-height, which is the same ratio
+  static float ProjectedSize(const AABB &bounds, const Vec3 &eye, float tanHalfFovY) noexcept;
+
+private:
+  DrawList() = default;
+
+public:
+  ~DrawList() = default;
+  DrawList(const DrawList &) = delete;
+  DrawList &operator=(const DrawList &) = delete;
+
+private:
+  std::unique_ptr<BVH> m_BVH;
+  std::vector<DrawObject> m_Objects;
+  std::vector<uint32_t> m_Visible;
+  std::vector<DrawItem> m_Items;
+  std::vector<DrawItem> m_Scratch;
+};
+} // namespace york
@@ -0,0 +1,197 @@
+#include "York/Scene/transform_hierarchy.hpp"
+#include "York/Core/error.hpp"
+#include "York/Core/job_system.hpp"
+#include "York/Core/profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <format>
+
+namespace york {
+
+// =====================
+// Hierarchy Creation
+// =====================
+Result<std::unique_ptr<TransformHierarchy>> TransformHierarchy::Create(const TransformHierarchyCreateInfo &createInfo) {
+  auto hierarchy = std::unique_ptr<TransformHierarchy>(new TransformHierarchy());
+  hierarchy->m_Jobs = createInfo.Jobs;
+  hierarchy->m_ParallelThreshold = std::max(createInfo.ParallelThreshold, 1U);
+
+  const auto &nodes = createInfo.Nodes;
+  const uint32_t count = static_cast<uint32_t>(nodes.size());
+
+  std::vector<std::vector<uint32_t>> children(count);
+  std::vector<uint32_t> order;
+  order.reserve(count);
+  for (uint32_t i(0); i < count; ++i) {
+    const int32_t parent = nodes[i].Parent;
+    if (parent < -1 || parent >= static_cast<int32_t>(count) || parent == static_cast<int32_t>(i))
+      return YK_RESULT_FAILURE(Error::Create(std::format("Node {} has an invalid parent {}", i, parent)));
+
+    if (parent == -1)
+      order.push_back(i);
+    else
+      children[parent].push_back(i);
+  }
+
+  // Breadth first from the roots: every depth is one contiguous range and siblings stay adjacent
+  hierarchy->m_LevelStarts.push_back(0);
+  for (size_t levelBegin = 0; levelBegin < order.size();) {
+    const size_t levelEnd = order.size();
+    hierarchy->m_LevelStarts.push_back(static_cast<uint32_t>(levelEnd));
+    for (size_t i = levelBegin; i < levelEnd; ++i)
+      order.insert(order.end(), children[order[i]].begin(), children[order[i]].end());
+    levelBegin = levelEnd;
+  }
+
+  // Nodes on a parent cycle are never reached from a root
+  if (order.size() != count)
+    return YK_RESULT_FAILURE(Error::Create(std::format("{} nodes are part of a parent cycle", count - order.size())));
+
+  hierarchy->m_SourceToNode.resize(count);
+  for (uint32_t i(0); i < count; ++i)
+    hierarchy->m_SourceToNode[order[i]] = i;
+
+  hierarchy->m_Parents.resize(count);
+  hierarchy->m_Depths.resize(count);
+  hierarchy->m_Translations.resize(count);
+  hierarchy->m_Rotations.resize(count);
+  hierarchy->m_Scales.resize(count);
+  hierarchy->m_Locals.resize(count);
+  hierarchy->m_Worlds.resize(count);
+  hierarchy->m_LocalDirty.assign(count, 1);
+  hierarchy->m_WorldChanged.assign(count, 0);
+
+  for (uint32_t depth(0); depth + 1 < hierarchy->m_LevelStarts.size(); ++depth) {
+    for (uint32_t i = hierarchy->m_LevelStarts[depth]; i < hierarchy->m_LevelStarts[depth + 1]; ++i) {
+      const auto &source = nodes[order[i]];
+      hierarchy->m_Parents[i] = source.Parent == -1 ? -1 : static_cast<int32_t>(hierarchy->m_SourceToNode[source.Parent]);
+      hierarchy->m_Depths[i] = depth;
+      hierarchy->m_Translations[i] = source.Translation;
+      hierarchy->m_Rotations[i] = source.Rotation;
+      hierarchy->m_Scales[i] = source.Scale;
+    }
+  }
+  hierarchy->m_MinDirtyDepth = count ? 0 : UINT32_MAX;
+
+  for (const auto &skin : createInfo.Skins) {
+    if (skin.InverseBindMatrices.size() != skin.Joints.size())
+      return YK_RESULT_FAILURE(Error::Create(std::format("Skin has {} joints but {} inverse bind matrices",
+                                                         skin.Joints.size(), skin.InverseBindMatrices.size())));
+
+    hierarchy->m_Skins.push_back({
+        .Offset = static_cast<uint32_t>(hierarchy->m_JointNodes.size()),
+        .Count = static_cast<uint32_t>(skin.Joints.size()),
+    });
+    for (uint32_t joint : skin.Joints) {
+      if (joint >= count)
+        return YK_RESULT_FAILURE(Error::Create(std::format("Skin joint {} does not exist", joint)));
+      hierarchy->m_JointNodes.push_back(hierarchy->m_SourceToNode[joint]);
+    }
+    hierarchy->m_InverseBinds.insert(hierarchy->m_InverseBinds.end(), skin.InverseBindMatrices.begin(), skin.InverseBindMatrices.end());
+  }
+
+  hierarchy->Update();
+  return YK_RESULT_SUCCESS(hierarchy);
+}
+
+// =====================
+// Local Transforms
+// =====================
+void TransformHierarchy::MarkDirty(uint32_t node) noexcept {
+  m_LocalDirty[node] = 1;
+  m_MinDirtyDepth = std::min(m_MinDirtyDepth, m_Depths[node]);
+}
+
+void TransformHierarchy::SetTranslation(uint32_t node, const Vec3 &translation) noexcept {
+  m_Translations[node] = translation;
+  MarkDirty(node);
+}
+
+void TransformHierarchy::SetRotation(uint32_t node, const Quat &rotation) noexcept {
+  m_Rotations[node] = rotation;
+  MarkDirty(node);
+}
+
+void TransformHierarchy::SetScale(uint32_t node, const Vec3 &scale) noexcept {
+  m_Scales[node] = scale;
+  MarkDirty(node);
+}
+
+void TransformHierarchy::SetLocal(uint32_t node, const Vec3 &translation, const Quat &rotation, const Vec3 &scale) noexcept {
+  m_Translations[node] = translation;
+  m_Rotations[node] = rotation;
+  m_Scales[node] = scale;
+  MarkDirty(node);
+}
+
+// =====================
+// Propagation
+// =====================
+void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end) noexcept {
+  for (uint32_t i = begin; i < end; ++i) {
+    const int32_t parent = m_Parents[i];
+    const bool parentChanged = parent >= 0 && m_WorldChanged[parent];
+    if (!m_LocalDirty[i] && !parentChanged)
+      continue;
+
+    if (m_LocalDirty[i]) {
+      m_Locals[i] = Compose(m_Translations[i], m_Rotations[i], m_Scales[i]);
+      m_LocalDirty[i] = 0;
+    }
+
+    m_Worlds[i] = parent >= 0 ? m_Worlds[parent] * m_Locals[i] : m_Locals[i];
+    m_WorldChanged[i] = 1;
+  }
+}
+
+void TransformHierarchy::Update() {
+  YK_PROFILE_FUNCTION();
+  if (m_MinDirtyDepth == UINT32_MAX) {
+    if (m_ChangedLastUpdate)
+      std::fill(m_WorldChanged.begin(), m_WorldChanged.end(), 0);
+    m_ChangedLastUpdate = false;
+    return;
+  }
+
+  // Everything above the shallowest dirty node keeps its world matrix
+  std::fill(m_WorldChanged.begin(), m_WorldChanged.end(), 0);
+
+  // Nodes of one depth only read parents of the previous depth, so each level is split freely
+  const uint32_t levels = static_cast<uint32_t>(m_LevelStarts.size()) - 1;
+  for (uint32_t depth = m_MinDirtyDepth; depth < levels; ++depth) {
+    const uint32_t begin = m_LevelStarts[depth];
+    const uint32_t end = m_LevelStarts[depth + 1];
+
+    if (m_Jobs && end - begin >= m_ParallelThreshold)
+      m_Jobs->ParallelFor(end - begin, m_ParallelThreshold / 4, [&](uint32_t b, uint32_t e) { UpdateRange(begin + b, begin + e); });
+    else
+      UpdateRange(begin, end);
+  }
+
+  m_MinDirtyDepth = UINT32_MAX;
+  m_ChangedLastUpdate = true;
+}
+
+// =====================
+// Skinning
+// =====================
+void TransformHierarchy::WriteJointMatrices(Mat4 *dst) const {
+  YK_PROFILE_FUNCTION();
+  const uint32_t count = GetTotalJointCount();
+  auto write = [&](uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i)
+      dst[i] = m_Worlds[m_JointNodes[i]] * m_InverseBinds[i];
+  };
+
+  if (m_Jobs && count >= m_ParallelThreshold)
+    m_Jobs->ParallelFor(count, m_ParallelThreshold / 4, write);
+  else
+    write(0, count);
+}
+
+void TransformHierarchy::WriteJointMatrices(uint32_t skin, Mat4 *dst) const {
+  const auto &range = m_Skins[skin];
+  for (uint32_t i(0); i < range.Count; ++i)
+    dst[i] = m_Worlds[m_JointNodes[range.Offset + i]] * m_InverseBinds[range.Offset + i];
+}
+} // namespace york
@@ -0,0 +1,122 @@
+#pragma once
+
+/*
+ * Flattened Transform Hierarchy
+ */
+
+#include "York/Core/result.hpp"
+#include "York/Math/math.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace york {
+class JobSystem;
+
+// Parent is an index into TransformHierarchyCreateInfo::Nodes, -1 for roots
+// Nodes may come in any order (e.g. the glTF node array with children resolved to parents)
+struct TransformNode {
+  int32_t Parent = -1;
+  Vec3 Translation{};
+  Quat Rotation{};
+  Vec3 Scale{1.0f, 1.0f, 1.0f};
+};
+
+// Joints are indices into TransformHierarchyCreateInfo::Nodes, one inverse bind matrix per joint
+struct SkinCreateInfo {
+  std::vector<uint32_t> Joints;
+  std::vector<Mat4> InverseBindMatrices;
+};
+
+// Levels with at least ParallelThreshold nodes are split across Jobs, a null Jobs keeps everything on the caller
+struct TransformHierarchyCreateInfo {
+  std::vector<TransformNode> Nodes;
+  std::vector<SkinCreateInfo> Skins;
+  JobSystem *Jobs = nullptr;
+  uint32_t ParallelThreshold = 2048;
+};
+
+// Nodes are stored sorted by depth (parents always before children, siblings adjacent) in SoA arrays
+// Node indices of the accessors are sorted indices, GetNodeIndex maps a source index to one
+// Usage:
+// hierarchy->SetRotation(node, q) for every animated node, then hierarchy->Update() once per frame
+// Only nodes whose local transform changed and their descendants are recomputed
+class TransformHierarchy {
+public:
+  static Result<std::unique_ptr<TransformHierarchy>> Create(const TransformHierarchyCreateInfo &createInfo);
+
+public:
+  uint32_t GetNodeIndex(uint32_t sourceIndex) const noexcept { return m_SourceToNode[sourceIndex]; }
+  uint32_t GetNodeCount() const noexcept { return static_cast<uint32_t>(m_Parents.size()); }
+  int32_t GetParent(uint32_t node) const noexcept { return m_Parents[node]; }
+
+  void SetTranslation(uint32_t node, const Vec3 &translation) noexcept;
+  void SetRotation(uint32_t node, const Quat &rotation) noexcept;
+  void SetScale(uint32_t node, const Vec3 &scale) noexcept;
+  void SetLocal(uint32_t node, const Vec3 &translation, const Quat &rotation, const Vec3 &scale) noexcept;
+
+  const Vec3 &GetTranslation(uint32_t node) const noexcept { return m_Translations[node]; }
+  const Quat &GetRotation(uint32_t node) const noexcept { return m_Rotations[node]; }
+  const Vec3 &GetScale(uint32_t node) const noexcept { return m_Scales[node]; }
+  const Mat4 &GetLocal(uint32_t node) const noexcept { return m_Locals[node]; }
+  const Mat4 &GetWorld(uint32_t node) const noexcept { return m_Worlds[node]; }
+
+  // Recomputes dirty subtrees, level by level from the shallowest dirty node
+  void Update();
+
+  // True when the world matrix of the node changed during the last Update
+  bool HasWorldChanged(uint32_t node) const noexcept { return m_WorldChanged[node] != 0; }
+
+  uint32_t GetSkinCount() const noexcept { return static_cast<uint32_t>(m_Skins.size()); }
+  uint32_t GetJointCount(uint32_t skin) const noexcept { return m_Skins[skin].Count; }
+  // Offset of the skin in the WriteJointMatrices output, in matrices
+  uint32_t GetJointOffset(uint32_t skin) const noexcept { return m_Skins[skin].Offset; }
+  uint32_t GetTotalJointCount() const noexcept { return static_cast<uint32_t>(m_JointNodes.size()); }
+
+  // Writes world * inverse bind of every joint of every skin to dst (GetTotalJointCount matrices)
+  // dst is meant to be a persistently mapped buffer (vulkan::JointBuffer), it is only written sequentially
+  void WriteJointMatrices(Mat4 *dst) const;
+  void WriteJointMatrices(uint32_t skin, Mat4 *dst) const;
+
+private:
+  TransformHierarchy() = default;
+
+  void MarkDirty(uint32_t node) noexcept;
+  void UpdateRange(uint32_t begin, uint32_t end) noexcept;
+
+public:
+  ~TransformHierarchy() = default;
+  TransformHierarchy(const TransformHierarchy &) = delete;
+  TransformHierarchy &operator=(const TransformHierarchy &) = delete;
+
+private:
+  struct SkinRange {
+    uint32_t Offset = 0;
+    uint32_t Count = 0;
+  };
+
+private:
+  JobSystem *m_Jobs = nullptr;
+  uint32_t m_ParallelThreshold = 0;
+
+  std::vector<uint32_t> m_SourceToNode;
+  std::vector<int32_t> m_Parents;
+  std::vector<uint32_t> m_Depths;
+  std::vector<Vec3> m_Translations;
+  std::vector<Quat> m_Rotations;
+  std::vector<Vec3> m_Scales;
+  std::vector<Mat4> m_Locals;
+  std::vector<Mat4> m_Worlds;
+  std::vector<uint8_t> m_LocalDirty;
+  std::vector<uint8_t> m_WorldChanged;
+
+  // m_LevelStarts[d] is the first node of depth d, the last entry is the node count
+  std::vector<uint32_t> m_LevelStarts;
+  uint32_t m_MinDirtyDepth = UINT32_MAX;
+  bool m_ChangedLastUpdate = false;
+
+  std::vector<SkinRange> m_Skins;
+  std::vector<uint32_t> m_JointNodes;
+  std::vector<Mat4> m_InverseBinds;
+};
+} // namespace york